@@ -0,0 +1,97 @@
+/**
+Fixed-memory histograms per sensor for long-run value distributions, weighted by the time each value was held.
+Temperatures and percentages use linear buckets, everything else HDR-style logarithmic buckets, all chosen from the sensor's unit.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#pragma once
+#include "../ArgusMonitor/argus_monitor_data_api.h"
+#include "../Layout/sensor_layout.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        enum HISTOGRAM_SCALE
+        {
+            HISTOGRAM_SCALE_TEMPERATURE = 0,    // linear, 0.25 wide buckets from 0 to 200
+            HISTOGRAM_SCALE_PERCENTAGE,         // linear, 0.25 wide buckets from 0 to 100
+            HISTOGRAM_SCALE_LOGARITHMIC,        // 16 buckets per power of two from 1 to 2^40, everything below 1 in the first bucket
+            HISTOGRAM_SCALE_MAX
+        };
+
+        class SensorHistogram
+        {
+        private:
+            HISTOGRAM_SCALE  scale;
+            vector<uint64_t> durations;                 // milliseconds spent in every bucket
+            uint64_t         total_ms         { 0 };
+            bool             has_value        { false };
+            float            min_value        { 0 };
+            float            max_value        { 0 };
+            bool             has_previous     { false };
+            uint32_t         previous_bucket  { 0 };
+            uint64_t         previous_time_ms { 0 };
+            uint64_t         previous_sequence{ 0 };
+
+            static constexpr float    kLinearBucketWidth = 0.25f;
+            static constexpr uint32_t kLogSubBuckets     = 16;
+            static constexpr uint32_t kLogOctaves        = 40;
+
+            uint32_t BucketIndex(const float& value) const;
+
+        public:
+            explicit SensorHistogram(const HISTOGRAM_SCALE& scale);
+
+            static HISTOGRAM_SCALE      ScaleFor(const ARGUS_MONITOR_SENSOR_TYPE& argus_sensor_type, const string& unit);
+            static uint32_t             BucketCount(const HISTOGRAM_SCALE& scale);
+            // lower bound of every bucket, shared by all histograms of the same scale
+            static const vector<float>& LowerBounds(const HISTOGRAM_SCALE& scale);
+
+            // the previous value is held until this sample, sequence numbers the observed cycles like for the integrators
+            // so a sensor missing from the previous cycle does not get the gap attributed to its last value
+            void   Record(const float& value, const uint64_t& timestamp_ms, const uint64_t& sequence);
+            float  Percentile(const double& quantile) const;
+            // share of the time spent above the threshold
+            double FractionAbove(const float& threshold) const;
+
+            inline HISTOGRAM_SCALE         Scale() const noexcept { return scale; }
+            inline const vector<uint64_t>& Durations() const noexcept { return durations; }
+            inline uint64_t                TotalMilliseconds() const noexcept { return total_ms; }
+        };
+
+        class HistogramStore
+        {
+        private:
+            map<const string, SensorHistogram> histograms;
+            vector<SensorHistogram*>           by_handle;
+            uint32_t                           layout_generation{ 0 };
+
+        public:
+            // map the handles of the given layout to their histograms, only does work if the layout changed since the last call
+            void Bind(const SensorLayout& layout);
+            void Clear();
+
+            inline void Record(const size_t& handle, const float& value, const uint64_t& timestamp_ms, const uint64_t& sequence) {
+                if (handle < by_handle.size()) by_handle[handle]->Record(value, timestamp_ms, sequence);
+            }
+
+            inline const SensorHistogram* Find(const string& sensor_id) const {
+                const auto& histogram = histograms.find(sensor_id);
+                return histograms.end() == histogram ? nullptr : &histogram->second;
+            }
+        };
+    }
+}
+
+#include "sensor_histogram.inl"
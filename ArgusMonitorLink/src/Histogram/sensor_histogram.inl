@@ -0,0 +1,200 @@
+/**
+Fixed-memory histograms per sensor for long-run value distributions, weighted by the time each value was held.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "sensor_histogram.h"
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        inline SensorHistogram::SensorHistogram(const HISTOGRAM_SCALE& scale)
+            : scale{ scale },
+              durations(BucketCount(scale), 0)
+        {
+        }
+
+        inline HISTOGRAM_SCALE SensorHistogram::ScaleFor(const ARGUS_MONITOR_SENSOR_TYPE& argus_sensor_type, const string& unit)
+        {
+            if ("%" == unit) return HISTOGRAM_SCALE_PERCENTAGE;
+            // the unit is narrowed from wchar_t, so '°' ends up as its latin-1 byte
+            if (string::npos != unit.find('\xB0')) return HISTOGRAM_SCALE_TEMPERATURE;
+
+            switch (argus_sensor_type)
+            {
+                case SENSOR_TYPE_TEMPERATURE:
+                case SENSOR_TYPE_SYNTHETIC_TEMPERATURE:
+                case SENSOR_TYPE_CPU_TEMPERATURE:
+                case SENSOR_TYPE_CPU_TEMPERATURE_ADDITIONAL:
+                case SENSOR_TYPE_GPU_TEMPERATURE:
+                case SENSOR_TYPE_DISK_TEMPERATURE:
+                    return HISTOGRAM_SCALE_TEMPERATURE;
+                case SENSOR_TYPE_FAN_CONTROL_VALUE:
+                case SENSOR_TYPE_CPU_LOAD:
+                case SENSOR_TYPE_GPU_LOAD:
+                case SENSOR_TYPE_GPU_FAN_SPEED_PERCENT:
+                case SENSOR_TYPE_GPU_MEMORY_USED_PERCENT:
+                case SENSOR_TYPE_BATTERY:
+                    return HISTOGRAM_SCALE_PERCENTAGE;
+                default:
+                    return HISTOGRAM_SCALE_LOGARITHMIC;
+            }
+        }
+
+        inline uint32_t SensorHistogram::BucketCount(const HISTOGRAM_SCALE& scale)
+        {
+            switch (scale)
+            {
+                case HISTOGRAM_SCALE_TEMPERATURE:
+                    return static_cast<uint32_t>(200 / kLinearBucketWidth) + 1;
+                case HISTOGRAM_SCALE_PERCENTAGE:
+                    return static_cast<uint32_t>(100 / kLinearBucketWidth) + 1;
+                case HISTOGRAM_SCALE_LOGARITHMIC:
+                default:
+                    return 1 + kLogOctaves * kLogSubBuckets;
+            }
+        }
+
+        inline const vector<float>& SensorHistogram::LowerBounds(const HISTOGRAM_SCALE& scale)
+        {
+            static const vector<vector<float>> lower_bounds = []()
+            {
+                vector<vector<float>> bounds(HISTOGRAM_SCALE_MAX);
+                for (int scale{}; scale < HISTOGRAM_SCALE_MAX; ++scale)
+                {
+                    const auto& bucket_count = BucketCount(static_cast<HISTOGRAM_SCALE>(scale));
+                    bounds[scale].reserve(bucket_count);
+                    for (uint32_t index{}; index < bucket_count; ++index)
+                    {
+                        if (HISTOGRAM_SCALE_LOGARITHMIC != scale)
+                        {
+                            bounds[scale].push_back(index * kLinearBucketWidth);
+                        }
+                        else if (0 == index)
+                        {
+                            bounds[scale].push_back(0);
+                        }
+                        else
+                        {
+                            const uint32_t octave = (index - 1) / kLogSubBuckets;
+                            const uint32_t sub_bucket = (index - 1) % kLogSubBuckets;
+                            bounds[scale].push_back(ldexp(1.0f + static_cast<float>(sub_bucket) / kLogSubBuckets, octave));
+                        }
+                    }
+                }
+                return bounds;
+            }();
+            return lower_bounds[scale];
+        }
+
+        inline uint32_t SensorHistogram::BucketIndex(const float& value) const
+        {
+            const uint32_t last = static_cast<uint32_t>(durations.size()) - 1;
+            if (!(value > 0)) return 0;
+
+            if (HISTOGRAM_SCALE_LOGARITHMIC != scale)
+            {
+                const float index = value / kLinearBucketWidth;
+                return index >= last ? last : static_cast<uint32_t>(index);
+            }
+
+            if (value < 1) return 0;
+
+            // value = mantissa * 2^exponent with mantissa in [0.5, 1)
+            int exponent;
+            const float mantissa = frexp(value, &exponent);
+            const uint32_t octave = static_cast<uint32_t>(exponent - 1);
+            if (octave >= kLogOctaves) return last;
+
+            const uint32_t sub_bucket = static_cast<uint32_t>((mantissa * 2 - 1) * kLogSubBuckets);
+            return 1 + octave * kLogSubBuckets + min(sub_bucket, kLogSubBuckets - 1);
+        }
+
+        inline void SensorHistogram::Record(const float& value, const uint64_t& timestamp_ms, const uint64_t& sequence)
+        {
+            if (has_previous && previous_sequence + 1 == sequence && timestamp_ms > previous_time_ms)
+            {
+                durations[previous_bucket] += timestamp_ms - previous_time_ms;
+                total_ms += timestamp_ms - previous_time_ms;
+            }
+
+            has_previous = true;
+            previous_bucket = BucketIndex(value);
+            previous_time_ms = timestamp_ms;
+            previous_sequence = sequence;
+
+            if (!has_value || value < min_value) min_value = value;
+            if (!has_value || value > max_value) max_value = value;
+            has_value = true;
+        }
+
+        // middle of the bucket holding the requested share of time, clamped to the observed range
+        inline float SensorHistogram::Percentile(const double& quantile) const
+        {
+            if (0 == total_ms) return 0;
+
+            const auto& bounds = LowerBounds(scale);
+            const uint64_t rank = max<uint64_t>(1, static_cast<uint64_t>(ceil(clamp(quantile, 0.0, 1.0) * total_ms)));
+
+            uint64_t seen{ 0 };
+            for (uint32_t index{}; index < durations.size(); ++index)
+            {
+                seen += durations[index];
+                if (seen >= rank)
+                {
+                    const float upper = index + 1 < bounds.size() ? bounds[index + 1] : max_value;
+                    return clamp((bounds[index] + upper) / 2, min_value, max_value);
+                }
+            }
+            return max_value;
+        }
+
+        // the bucket holding the threshold is split linearly
+        inline double SensorHistogram::FractionAbove(const float& threshold) const
+        {
+            if (0 == total_ms) return 0;
+
+            const auto& bounds = LowerBounds(scale);
+            const uint32_t first = BucketIndex(threshold);
+            const float lower = bounds[first];
+            const float upper = first + 1 < bounds.size() ? bounds[first + 1] : max(max_value, lower);
+
+            double above = upper > lower ? durations[first] * clamp((upper - threshold) / (upper - lower), 0.0f, 1.0f) : 0;
+            for (uint32_t index{ first + 1 }; index < durations.size(); ++index)
+            {
+                above += durations[index];
+            }
+            return above / total_ms;
+        }
+
+        inline void HistogramStore::Bind(const SensorLayout& layout)
+        {
+            if (layout.Generation() == layout_generation) return;
+
+            layout_generation = layout.Generation();
+            by_handle.clear();
+            by_handle.reserve(layout.Records().size());
+            for (const auto& record : layout.Records())
+            {
+                const string sensor_id(layout.String(record.SensorIdOffset));
+                auto histogram = histograms.find(sensor_id);
+                if (histograms.end() == histogram)
+                {
+                    const auto& scale = SensorHistogram::ScaleFor(static_cast<ARGUS_MONITOR_SENSOR_TYPE>(record.ArgusSensorType), layout.String(record.UnitOffset));
+                    histogram = histograms.emplace(sensor_id, SensorHistogram(scale)).first;
+                }
+                by_handle.push_back(&histogram->second);
+            }
+        }
+
+        inline void HistogramStore::Clear()
+        {
+            histograms.clear();
+            by_handle.clear();
+            layout_generation = 0;
+        }
+    }
+}
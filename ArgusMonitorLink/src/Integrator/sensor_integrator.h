@@ -0,0 +1,66 @@
+/**
+Incremental integrators over the observed Argus Monitor cycles: energy, total bytes transferred and time above a threshold.
+Accumulators are advanced with the real elapsed time between two observed cycles, so missed cycles do not skew the totals.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#pragma once
+#include "../ArgusMonitor/argus_monitor_data_api.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+using namespace std;
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        struct SensorAccumulator
+        {
+            bool     has_sample    { false };
+            uint64_t last_sequence { 0 };       // observation sequence of the last sample
+            uint64_t last_time_ms  { 0 };
+            double   last_rate     { 0 };       // raw value scaled to units per second of the integrated total
+            float    last_value    { 0 };       // value as published by UpdateSensorData
+            bool     is_integrated { false };
+            double   total         { 0 };       // Wh for power, bytes for transfer rates
+            bool     has_threshold { false };
+            float    threshold     { 0 };
+            double   seconds_above { 0 };
+        };
+
+        class SensorIntegrator
+        {
+        private:
+            map<const string, SensorAccumulator> accumulators;
+            size_t                               threshold_count{ 0 };
+
+        public:
+            // sensor type of the derived total sensor, nullptr if the given type is not integrated
+            static const char* IntegratedSensorType(const ARGUS_MONITOR_SENSOR_TYPE& argus_sensor_type);
+            // factor converting the raw Argus Monitor value into units of the total per second
+            static double      IntegrationScale(const ARGUS_MONITOR_SENSOR_TYPE& argus_sensor_type);
+
+            void SetThreshold(const string& sensor_id, const float& threshold);
+            void ClearThreshold(const string& sensor_id);
+            // reset all totals while keeping the configured thresholds
+            void Reset();
+            // keep the totals but start integrating anew from the next sample, e.g. after reconnecting
+            void Restart();
+
+            // advance the accumulator of the given sensor, returns nullptr if the sensor is neither integrated nor has a threshold
+            // sequence numbers the observed cycles, a sensor missing from the previous one is not integrated across the gap
+            const SensorAccumulator* Observe(const string& sensor_id,
+                                             const ARGUS_MONITOR_SENSOR_TYPE& argus_sensor_type,
+                                             const double raw_value,
+                                             const float& value,
+                                             const uint64_t& timestamp_ms,
+                                             const uint64_t& sequence);
+        };
+    }
+}
+
+#include "sensor_integrator.inl"
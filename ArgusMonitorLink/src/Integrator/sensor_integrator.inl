@@ -0,0 +1,146 @@
+/**
+Incremental integrators over the observed Argus Monitor cycles: energy, total bytes transferred and time above a threshold.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "sensor_integrator.h"
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        inline const char* SensorIntegrator::IntegratedSensorType(const ARGUS_MONITOR_SENSOR_TYPE& argus_sensor_type)
+        {
+            switch (argus_sensor_type)
+            {
+                case SENSOR_TYPE_GPU_POWER:
+                    return "Energy";
+                case SENSOR_TYPE_NETWORK_SPEED:
+                case SENSOR_TYPE_DISK_TRANSFER_RATE:
+                    return "Data";
+                default:
+                    return nullptr;
+            }
+        }
+
+        inline double SensorIntegrator::IntegrationScale(const ARGUS_MONITOR_SENSOR_TYPE& argus_sensor_type)
+        {
+            switch (argus_sensor_type)
+            {
+                case SENSOR_TYPE_GPU_POWER:
+                    return 1.0 / 3600; // W => Wh per second
+                case SENSOR_TYPE_NETWORK_SPEED:
+                case SENSOR_TYPE_DISK_TRANSFER_RATE:
+                    return 1000000; // MB/s => bytes per second
+                default:
+                    return 0;
+            }
+        }
+
+        inline void SensorIntegrator::SetThreshold(const string& sensor_id, const float& threshold)
+        {
+            auto& accumulator = accumulators[sensor_id];
+            if (!accumulator.has_threshold) ++threshold_count;
+
+            accumulator.has_threshold = true;
+            accumulator.threshold = threshold;
+            accumulator.seconds_above = 0;
+        }
+
+        inline void SensorIntegrator::ClearThreshold(const string& sensor_id)
+        {
+            const auto& accumulator = accumulators.find(sensor_id);
+            if (accumulators.end() == accumulator || !accumulator->second.has_threshold) return;
+
+            --threshold_count;
+            if (accumulator->second.is_integrated)
+            {
+                accumulator->second.has_threshold = false;
+                accumulator->second.seconds_above = 0;
+            }
+            else
+            {
+                accumulators.erase(accumulator);
+            }
+        }
+
+        inline void SensorIntegrator::Reset()
+        {
+            for (auto& accumulator : accumulators)
+            {
+                accumulator.second.has_sample = false;
+                accumulator.second.total = 0;
+                accumulator.second.seconds_above = 0;
+            }
+        }
+
+        inline void SensorIntegrator::Restart()
+        {
+            for (auto& accumulator : accumulators)
+            {
+                accumulator.second.has_sample = false;
+            }
+        }
+
+        inline const SensorAccumulator* SensorIntegrator::Observe(const string& sensor_id,
+                                                                  const ARGUS_MONITOR_SENSOR_TYPE& argus_sensor_type,
+                                                                  const double raw_value,
+                                                                  const float& value,
+                                                                  const uint64_t& timestamp_ms,
+                                                                  const uint64_t& sequence)
+        {
+            const bool is_integrated = nullptr != IntegratedSensorType(argus_sensor_type);
+            if (!is_integrated && 0 == threshold_count) return nullptr;
+
+            SensorAccumulator* accumulator;
+            if (is_integrated)
+            {
+                accumulator = &accumulators[sensor_id];
+                accumulator->is_integrated = true;
+            }
+            else
+            {
+                const auto& found = accumulators.find(sensor_id);
+                if (accumulators.end() == found) return nullptr;
+                accumulator = &found->second;
+            }
+
+            // the sensor was absent from the previous observed cycle (hardware disabled, value filtered out, ...), restart from this sample
+            if (accumulator->has_sample && accumulator->last_sequence + 1 != sequence) accumulator->has_sample = false;
+
+            const double rate = raw_value * IntegrationScale(argus_sensor_type);
+            if (accumulator->has_sample && timestamp_ms > accumulator->last_time_ms)
+            {
+                const double elapsed_seconds = (timestamp_ms - accumulator->last_time_ms) / 1000.0;
+
+                // trapezoidal rule between the two observed cycles
+                if (is_integrated) accumulator->total += (accumulator->last_rate + rate) / 2 * elapsed_seconds;
+
+                if (accumulator->has_threshold)
+                {
+                    const bool was_above = accumulator->last_value > accumulator->threshold;
+                    const bool is_above = value > accumulator->threshold;
+                    if (was_above && is_above)
+                    {
+                        accumulator->seconds_above += elapsed_seconds;
+                    }
+                    else if (was_above != is_above)
+                    {
+                        // assume a linear transition and only count the part above the threshold
+                        const double crossing = (accumulator->threshold - accumulator->last_value) / (value - accumulator->last_value);
+                        accumulator->seconds_above += elapsed_seconds * (is_above ? 1 - crossing : crossing);
+                    }
+                }
+            }
+
+            accumulator->has_sample = true;
+            accumulator->last_sequence = sequence;
+            accumulator->last_time_ms = timestamp_ms;
+            accumulator->last_rate = rate;
+            accumulator->last_value = value;
+            return accumulator;
+        }
+    }
+}
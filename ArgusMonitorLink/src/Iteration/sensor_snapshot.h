@@ -0,0 +1,117 @@
+/**
+Lazy pull-style iteration over a captured copy of the Argus Monitor sensor data.
+The shared memory is only locked while copying the raw sensor entries, decoding happens for the elements that are actually pulled.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#pragma once
+#include "../ArgusMonitor/argus_monitor_data_api.h"
+#include "../Utility/utility.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        struct SensorSample
+        {
+            uint32_t                  handle;               // index into ArgusMonitorData::SensorData
+            ARGUS_MONITOR_SENSOR_TYPE argus_sensor_type;
+            uint32_t                  sensor_index;
+            uint32_t                  data_index;
+            string                    sensor_id;            // id as passed to UpdateSensorData
+            string                    name;
+            const char*               hardware_type;
+            const char*               sensor_type;
+            const char*               sensor_group;
+            float                     value;
+        };
+
+        class SensorSnapshot
+        {
+        private:
+            uint32_t                       cycle_counter{ 0 };
+            vector<ArgusMonitorSensorData> sensors;
+            vector<bool>                   enabled;
+
+        public:
+            class Iterator
+            {
+            private:
+                const SensorSnapshot* snapshot{ nullptr };
+                size_t                index   { 0 };
+
+                inline void SkipDisabled() { while (index < snapshot->sensors.size() && !snapshot->enabled[index]) ++index; }
+
+            public:
+                using iterator_concept  = input_iterator_tag;
+                using iterator_category = input_iterator_tag;
+                using value_type        = SensorSample;
+                using difference_type   = ptrdiff_t;
+                using reference         = SensorSample;
+
+                Iterator() = default;
+                Iterator(const SensorSnapshot* snapshot, const size_t& index) : snapshot{ snapshot }, index{ index } { SkipDisabled(); }
+
+                inline SensorSample operator*() const { return snapshot->Decode(index); }
+                inline Iterator&    operator++() { ++index; SkipDisabled(); return *this; }
+                inline Iterator     operator++(int) { Iterator previous{ *this }; ++*this; return previous; }
+                inline bool         operator==(const Iterator& other) const noexcept { return index == other.index; }
+            };
+
+            SensorSnapshot() = default;
+            // copy the raw sensor entries, enabled[i] tells whether the hardware type of sensor i is enabled
+            SensorSnapshot(const ArgusMonitorData& data, vector<bool>&& enabled);
+
+            SensorSample Decode(const size_t& index) const;
+
+            inline Iterator begin() const { return Iterator(this, 0); }
+            inline Iterator end() const { return Iterator(this, sensors.size()); }
+            inline uint32_t CycleCounter() const noexcept { return cycle_counter; }
+        };
+
+        // fixed-size sample passed to foreign callers, the strings stay valid until the next call to Next or EndIterate
+        struct SensorSampleRecord
+        {
+            std::uint32_t Handle;
+            std::uint32_t ArgusSensorType;
+            std::uint32_t SensorIndex;
+            std::uint32_t DataIndex;
+            float         Value;
+            const char*   SensorId;
+            const char*   Name;
+            const char*   HardwareType;
+            const char*   SensorType;
+            const char*   SensorGroup;
+        };
+
+        // cursor wrapping the lazy iteration for the C exports
+        class SensorCursor
+        {
+        private:
+            SensorSnapshot           snapshot;
+            SensorSnapshot::Iterator current;
+            SensorSample             sample{};
+
+        public:
+            explicit SensorCursor(SensorSnapshot&& snapshot) : snapshot{ std::move(snapshot) } { current = this->snapshot.begin(); }
+
+            SensorCursor(SensorCursor const&)            = delete;
+            SensorCursor(SensorCursor&&)                 = delete;
+            SensorCursor& operator=(SensorCursor const&) = delete;
+            SensorCursor& operator=(SensorCursor&&)      = delete;
+
+            bool Next(SensorSampleRecord& record);
+        };
+    }
+}
+
+#include "sensor_snapshot.inl"
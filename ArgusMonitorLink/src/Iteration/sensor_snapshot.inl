@@ -0,0 +1,59 @@
+/**
+Lazy pull-style iteration over a captured copy of the Argus Monitor sensor data.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "sensor_snapshot.h"
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        inline SensorSnapshot::SensorSnapshot(const ArgusMonitorData& data, vector<bool>&& enabled)
+            : cycle_counter{ data.CycleCounter },
+              sensors(data.SensorData, data.SensorData + min(static_cast<uint32_t>(data.TotalSensorCount), kMaxSensorCount)),
+              enabled{ std::move(enabled) }
+        {
+            this->enabled.resize(sensors.size(), false);
+        }
+
+        inline SensorSample SensorSnapshot::Decode(const size_t& index) const
+        {
+            const auto& sensor_data = sensors[index];
+            const wstring label(sensor_data.Label);
+
+            SensorSample sample{};
+            sample.handle = static_cast<uint32_t>(index);
+            sample.argus_sensor_type = sensor_data.SensorType;
+            sample.sensor_index = sensor_data.SensorIndex;
+            sample.data_index = sensor_data.DataIndex;
+            sample.name = string(label.begin(), label.end());
+            ParseTypes(sensor_data.SensorType, sample.name, sample.hardware_type, sample.sensor_type, sample.sensor_group);
+            sample.sensor_id = SensorId(sample.hardware_type, sample.sensor_type, sample.sensor_group, sample.sensor_index, sample.data_index);
+            sample.value = GetFloatValue(sensor_data.Value, sample.sensor_type);
+            return sample;
+        }
+
+        inline bool SensorCursor::Next(SensorSampleRecord& record)
+        {
+            if (snapshot.end() == current) return false;
+
+            sample = *current;
+            ++current;
+
+            record = { sample.handle,
+                       static_cast<uint32_t>(sample.argus_sensor_type),
+                       sample.sensor_index,
+                       sample.data_index,
+                       sample.value,
+                       sample.sensor_id.c_str(),
+                       sample.name.c_str(),
+                       sample.hardware_type,
+                       sample.sensor_type,
+                       sample.sensor_group };
+            return true;
+        }
+    }
+}
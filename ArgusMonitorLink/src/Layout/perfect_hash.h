@@ -0,0 +1,44 @@
+/**
+Collision-free index (hash and displace) over a fixed set of keys, rebuilt whenever the sensor layout changes.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        class PerfectHash
+        {
+        private:
+            vector<uint32_t> seeds;    // displacement seed per bucket
+            vector<uint32_t> slots;    // value per slot, kNotFound if unused
+
+            static inline uint64_t HashKey(const string_view& key);
+            static inline uint64_t Mix(const uint64_t& hash, const uint32_t& seed);
+            bool TryBuild(const vector<uint64_t>& hashes, const vector<uint32_t>& values, const size_t& slot_count);
+
+        public:
+            static constexpr uint32_t kNotFound = UINT32_MAX;
+
+            // build the index, keys must be unique, values[i] is returned for keys[i]
+            void Build(const vector<string_view>& keys, const vector<uint32_t>& values);
+            void Clear();
+
+            // returns the value stored for the slot the key maps to, the caller has to verify the key itself
+            // since keys that are not part of the set map to an arbitrary slot as well
+            uint32_t Find(const string_view& key) const;
+        };
+    }
+}
+
+#include "perfect_hash.inl"
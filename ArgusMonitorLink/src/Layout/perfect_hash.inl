@@ -0,0 +1,115 @@
+/**
+Collision-free index (hash and displace) over a fixed set of keys, rebuilt whenever the sensor layout changes.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "perfect_hash.h"
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        // FNV-1a
+        inline uint64_t PerfectHash::HashKey(const string_view& key)
+        {
+            uint64_t hash{ 14695981039346656037ULL };
+            for (const auto& character : key)
+            {
+                hash ^= static_cast<uint8_t>(character);
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        // splitmix64 finalizer over the key hash and the bucket seed
+        inline uint64_t PerfectHash::Mix(const uint64_t& hash, const uint32_t& seed)
+        {
+            uint64_t mixed = hash + 0x9E3779B97F4A7C15ULL * (static_cast<uint64_t>(seed) + 1);
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+            return mixed ^ (mixed >> 31);
+        }
+
+        inline bool PerfectHash::TryBuild(const vector<uint64_t>& hashes, const vector<uint32_t>& values, const size_t& slot_count)
+        {
+            const size_t bucket_count = max<size_t>(1, hashes.size() / 4);
+            vector<vector<uint32_t>> buckets(bucket_count);
+            for (uint32_t key{}; key < hashes.size(); ++key)
+            {
+                buckets[hashes[key] % bucket_count].push_back(key);
+            }
+
+            // place the largest buckets first while most slots are still free
+            vector<uint32_t> order(bucket_count);
+            for (uint32_t bucket{}; bucket < bucket_count; ++bucket) order[bucket] = bucket;
+            sort(order.begin(), order.end(), [&](const uint32_t& a, const uint32_t& b) { return buckets[a].size() > buckets[b].size(); });
+
+            seeds.assign(bucket_count, 0);
+            slots.assign(slot_count, kNotFound);
+
+            vector<size_t> placed;
+            for (const auto& bucket : order)
+            {
+                if (buckets[bucket].empty()) break;
+
+                bool found{ false };
+                for (uint32_t seed{}; seed < 0x10000 && !found; ++seed)
+                {
+                    placed.clear();
+                    found = true;
+                    for (const auto& key : buckets[bucket])
+                    {
+                        const size_t slot = Mix(hashes[key], seed) % slot_count;
+                        if (kNotFound != slots[slot] || placed.end() != find(placed.begin(), placed.end(), slot))
+                        {
+                            found = false;
+                            break;
+                        }
+                        placed.push_back(slot);
+                    }
+
+                    if (found)
+                    {
+                        seeds[bucket] = seed;
+                        for (size_t index{}; index < placed.size(); ++index)
+                        {
+                            slots[placed[index]] = values[buckets[bucket][index]];
+                        }
+                    }
+                }
+
+                if (!found) return false;
+            }
+            return true;
+        }
+
+        inline void PerfectHash::Build(const vector<string_view>& keys, const vector<uint32_t>& values)
+        {
+            Clear();
+            if (keys.empty()) return;
+
+            vector<uint64_t> hashes;
+            hashes.reserve(keys.size());
+            for (const auto& key : keys) hashes.push_back(HashKey(key));
+
+            // start with a load factor of 0.8 and grow the table if no seed could be found for a bucket
+            for (size_t slot_count{ keys.size() + keys.size() / 4 + 1 }; !TryBuild(hashes, values, slot_count); slot_count += slot_count / 4 + 1) {}
+        }
+
+        inline void PerfectHash::Clear()
+        {
+            seeds.clear();
+            slots.clear();
+        }
+
+        inline uint32_t PerfectHash::Find(const string_view& key) const
+        {
+            if (slots.empty()) return kNotFound;
+
+            const uint64_t hash = HashKey(key);
+            return slots[Mix(hash, seeds[hash % seeds.size()]) % slots.size()];
+        }
+    }
+}
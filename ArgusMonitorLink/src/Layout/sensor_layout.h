@@ -0,0 +1,87 @@
+/**
+Read-only sensor metadata table built once per Argus Monitor sensor layout.
+All strings are interned into a single pool and referenced by offset, so the table can be viewed directly by foreign callers.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#pragma once
+#include "../ArgusMonitor/argus_monitor_data_api.h"
+#include "../Utility/utility.h"
+#include "perfect_hash.h"
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        // fixed-size record, every string is an offset into the string pool pointing to a null terminated string
+        struct SensorMetadataRecord
+        {
+            std::uint32_t Handle;               // index into ArgusMonitorData::SensorData
+            std::uint32_t ArgusSensorType;      // ARGUS_MONITOR_SENSOR_TYPE
+            std::uint32_t SensorIndex;
+            std::uint32_t DataIndex;
+            std::uint32_t SensorIdOffset;       // id as passed to UpdateSensorData
+            std::uint32_t NameOffset;
+            std::uint32_t UnitOffset;
+            std::uint32_t HardwareTypeOffset;
+            std::uint32_t SensorTypeOffset;
+            std::uint32_t SensorGroupOffset;
+        };
+        static_assert(sizeof(SensorMetadataRecord) == 40, "SensorMetadataRecord is part of the exported ABI");
+
+        class SensorLayout
+        {
+        private:
+            bool                         is_built                                        { false };
+            uint32_t                     verified_cycle                                  { 0 };    // CycleCounter of the last full check, 0 if none
+            uint32_t                     generation                                      { 0 };
+            uint32_t                     total_sensor_count                              { 0 };
+            uint32_t                     offset_for_sensor_type[SENSOR_TYPE_MAX_SENSORS] {};
+            uint32_t                     sensor_count[SENSOR_TYPE_MAX_SENSORS]           {};
+            vector<SensorMetadataRecord> records;
+            vector<uint64_t>             entry_hashes;    // EntryHash of every sensor the records were built from
+            vector<char>                 string_pool;
+            map<const string, uint32_t>  interned_strings;
+            PerfectHash                  sensor_id_index;
+
+            uint32_t        Intern(const string& value);
+            void            Build(const ArgusMonitorData& data);
+            static uint64_t EntryHash(const ArgusMonitorSensorData& sensor_data);
+
+        public:
+            // the layout is identified by the sensor count, the per type offsets/counts of the shared memory header
+            // and the type, indices and label of every sensor
+            bool IsCurrent(const ArgusMonitorData& data) const;
+            // only compares the shared memory header, a cheap pre-check for IsCurrent
+            bool HasSameHeader(const ArgusMonitorData& data) const;
+            // check whether the sensor at the given handle is still the one the record was built from
+            bool Matches(const ArgusMonitorData& data, const uint32_t& handle) const;
+            // rebuild the table if the layout changed, returns true if it was rebuilt
+            bool Refresh(const ArgusMonitorData& data);
+            // like Refresh, but the full per sensor check runs at most once per CycleCounter
+            bool Verify(const ArgusMonitorData& data);
+            void Reset();
+
+            // O(1) lookup of the record index (== handle) for the given sensor id, PerfectHash::kNotFound if unknown
+            uint32_t FindHandle(const string_view& sensor_id) const;
+
+            // incremented on every rebuild, so callers can tell whether a previously obtained table is still valid
+            inline uint32_t                            Generation() const noexcept { return generation; }
+            inline const vector<SensorMetadataRecord>& Records() const noexcept { return records; }
+            inline const vector<char>&                 StringPool() const noexcept { return string_pool; }
+            inline const char*                         String(const uint32_t& offset) const { return string_pool.data() + offset; }
+        };
+    }
+}
+
+#include "sensor_layout.inl"
@@ -0,0 +1,168 @@
+/**
+Read-only sensor metadata table built once per Argus Monitor sensor layout.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "sensor_layout.h"
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        inline uint32_t SensorLayout::Intern(const string& value)
+        {
+            const auto& interned = interned_strings.find(value);
+            if (interned_strings.end() != interned) return interned->second;
+
+            const auto& offset = static_cast<uint32_t>(string_pool.size());
+            string_pool.insert(string_pool.end(), value.begin(), value.end());
+            string_pool.push_back('\0');
+            interned_strings.emplace(value, offset);
+            return offset;
+        }
+
+        // FNV-1a over the fields the record of a sensor is derived from
+        inline uint64_t SensorLayout::EntryHash(const ArgusMonitorSensorData& sensor_data)
+        {
+            uint64_t hash{ 14695981039346656037ULL };
+            const auto& add = [&hash](const uint64_t& value)
+            {
+                hash ^= value;
+                hash *= 1099511628211ULL;
+            };
+
+            add(static_cast<uint64_t>(sensor_data.SensorType));
+            add(sensor_data.SensorIndex);
+            add(sensor_data.DataIndex);
+            for (uint32_t index{}; index < kMaxLenLabel && L'\0' != sensor_data.Label[index]; ++index)
+            {
+                add(static_cast<uint64_t>(sensor_data.Label[index]));
+            }
+            return hash;
+        }
+
+        inline bool SensorLayout::HasSameHeader(const ArgusMonitorData& data) const
+        {
+            return is_built
+                && total_sensor_count == data.TotalSensorCount
+                && 0 == memcmp(offset_for_sensor_type, data.OffsetForSensorType, sizeof(offset_for_sensor_type))
+                && 0 == memcmp(sensor_count, data.SensorCount, sizeof(sensor_count));
+        }
+
+        inline bool SensorLayout::Matches(const ArgusMonitorData& data, const uint32_t& handle) const
+        {
+            return handle < entry_hashes.size() && entry_hashes[handle] == EntryHash(data.SensorData[handle]);
+        }
+
+        inline bool SensorLayout::IsCurrent(const ArgusMonitorData& data) const
+        {
+            if (!HasSameHeader(data)) return false;
+
+            for (uint32_t handle{}; handle < entry_hashes.size(); ++handle)
+            {
+                if (!Matches(data, handle)) return false;
+            }
+            return true;
+        }
+
+        inline bool SensorLayout::Refresh(const ArgusMonitorData& data)
+        {
+            if (IsCurrent(data)) return false;
+
+            Build(data);
+            return true;
+        }
+
+        inline bool SensorLayout::Verify(const ArgusMonitorData& data)
+        {
+            // the shared memory only changes together with the cycle counter
+            if (is_built && 0 != verified_cycle && verified_cycle == data.CycleCounter && HasSameHeader(data)) return false;
+
+            verified_cycle = data.CycleCounter;
+            return Refresh(data);
+        }
+
+        inline void SensorLayout::Reset()
+        {
+            is_built = false;
+            verified_cycle = 0;
+            records.clear();
+            entry_hashes.clear();
+            string_pool.clear();
+            sensor_id_index.Clear();
+        }
+
+        inline uint32_t SensorLayout::FindHandle(const string_view& sensor_id) const
+        {
+            const uint32_t handle = sensor_id_index.Find(sensor_id);
+            if (PerfectHash::kNotFound == handle || sensor_id != String(records[handle].SensorIdOffset)) return PerfectHash::kNotFound;
+
+            return handle;
+        }
+
+        inline void SensorLayout::Build(const ArgusMonitorData& data)
+        {
+            records.clear();
+            entry_hashes.clear();
+            string_pool.clear();
+            interned_strings.clear();
+
+            total_sensor_count = data.TotalSensorCount;
+            memcpy(offset_for_sensor_type, data.OffsetForSensorType, sizeof(offset_for_sensor_type));
+            memcpy(sensor_count, data.SensorCount, sizeof(sensor_count));
+
+            records.reserve(total_sensor_count);
+            entry_hashes.reserve(total_sensor_count);
+            for (uint32_t index{}; index < total_sensor_count && index < kMaxSensorCount; ++index)
+            {
+                const auto& sensor_data = data.SensorData[index];
+                entry_hashes.push_back(EntryHash(sensor_data));
+
+                const wstring label(sensor_data.Label);
+                const string name(label.begin(), label.end());
+                const wstring unit_label(sensor_data.UnitString);
+                const string unit(unit_label.begin(), unit_label.end());
+                const char* hardware_type;
+                const char* sensor_type;
+                const char* sensor_group;
+                ParseTypes(sensor_data.SensorType, name, hardware_type, sensor_type, sensor_group);
+
+                records.push_back({ index,
+                                    static_cast<uint32_t>(sensor_data.SensorType),
+                                    sensor_data.SensorIndex,
+                                    sensor_data.DataIndex,
+                                    Intern(SensorId(hardware_type,
+                                                    sensor_type,
+                                                    sensor_group,
+                                                    sensor_data.SensorIndex,
+                                                    sensor_data.DataIndex)),
+                                    Intern(name),
+                                    Intern(unit),
+                                    Intern(hardware_type),
+                                    Intern(sensor_type),
+                                    Intern(sensor_group) });
+            }
+
+            // the pool is final now, the lookup map is only needed while building
+            interned_strings.clear();
+
+            // index every distinct sensor id, the first sensor wins if an id is not unique
+            vector<string_view> sensor_ids;
+            vector<uint32_t> handles;
+            vector<bool> indexed(string_pool.size(), false);
+            for (const auto& record : records)
+            {
+                if (indexed[record.SensorIdOffset]) continue;
+
+                indexed[record.SensorIdOffset] = true;
+                sensor_ids.emplace_back(String(record.SensorIdOffset));
+                handles.push_back(record.Handle);
+            }
+            sensor_id_index.Build(sensor_ids, handles);
+            is_built = true;
+            ++generation;
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/**
+Linux data source producing the Argus Monitor shared memory layout from /sys/class/hwmon, /proc/stat and /proc/meminfo.
+The sensor layout is scanned once on Open, every file stays open and is read with pread on every cycle.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#pragma once
+
+#if defined(__linux__)
+
+#include "../ArgusMonitor/argus_monitor_data_api.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <fcntl.h>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        class HwmonDataSource
+        {
+        private:
+            enum SOURCE_KIND
+            {
+                SOURCE_KIND_FILE = 0,    // single value file, value = raw * scale
+                SOURCE_KIND_CPU_LOAD,    // per core load from /proc/stat
+                SOURCE_KIND_RAM_TOTAL,
+                SOURCE_KIND_RAM_USED,
+                SOURCE_KIND_RAM_PERCENTAGE
+            };
+
+            struct SensorSource
+            {
+                SOURCE_KIND               kind;
+                ARGUS_MONITOR_SENSOR_TYPE sensor_type;
+                wstring                   label;
+                wstring                   unit;
+                int                       fd;
+                double                    scale;
+                uint32_t                  core;           // core of SOURCE_KIND_CPU_LOAD
+                uint32_t                  sensor_index;
+                uint32_t                  data_index;
+            };
+
+            enum CHIP_KIND
+            {
+                CHIP_KIND_CPU = 0,
+                CHIP_KIND_GPU,
+                CHIP_KIND_DRIVE,
+                CHIP_KIND_MAINBOARD,
+                CHIP_KIND_MAX
+            };
+
+            struct CpuTimes
+            {
+                uint64_t busy { 0 };
+                uint64_t total{ 0 };
+            };
+
+            const string         hwmon_root;
+            const string         proc_root;
+            bool                 is_open       { false };
+            int                  stat_fd       { -1 };
+            int                  meminfo_fd    { -1 };
+            uint32_t             cycle_counter { 0 };
+            vector<SensorSource> sources;                 // sorted by sensor type
+            vector<CpuTimes>     last_cpu_times;
+            vector<double>       cpu_loads;
+            vector<char>         buffer;
+            uint32_t             offset_for_sensor_type[SENSOR_TYPE_MAX_SENSORS] {};
+            uint32_t             sensor_count[SENSOR_TYPE_MAX_SENSORS]           {};
+
+            static string    ReadText(const filesystem::path& path);
+            static wstring   DecodeUtf8(const string& text);
+            bool             ReadFd(const int& fd, size_t& length);
+            void             ScanHwmon();
+            static CHIP_KIND ChipKind(const string& name);
+            void             ScanChip(const filesystem::path& chip, const string& name, const CHIP_KIND& kind, const uint32_t& sensor_index);
+            void             AddFile(const filesystem::path& path, const ARGUS_MONITOR_SENSOR_TYPE& sensor_type, const wstring& label, const wchar_t* unit, const double& scale, const uint32_t& sensor_index);
+            void             ReadCpuLoads();
+
+        public:
+            explicit HwmonDataSource(const string& hwmon_root = "/sys/class/hwmon", const string& proc_root = "/proc")
+                : hwmon_root{ hwmon_root }, proc_root{ proc_root } {}
+
+            HwmonDataSource(HwmonDataSource const&)            = delete;
+            HwmonDataSource(HwmonDataSource&&)                 = delete;
+            HwmonDataSource& operator=(HwmonDataSource const&) = delete;
+            HwmonDataSource& operator=(HwmonDataSource&&)      = delete;
+
+            ~HwmonDataSource() { Close(); }
+
+            // scan the sensors and open all files
+            // return:
+            //   0: data source is open
+            //   1: could not read the hwmon directory
+            //  10: could not open /proc/stat
+            // 100: could not open /proc/meminfo
+            int  Open();
+            inline bool IsOpen() const noexcept { return is_open; }
+            int  Close();
+
+            inline size_t GetTotalSensorCount() const noexcept { return sources.size(); }
+
+            // read every sensor once and write a complete frame with an incremented CycleCounter
+            // the frame is written with plain stores, readers have to be synchronized with this call externally,
+            // just like Argus Monitor readers use its mutex
+            void Sample(ArgusMonitorData& data);
+        };
+    }
+}
+
+#include "hwmon_data_source.inl"
+
+#endif
@@ -0,0 +1,406 @@
+/**
+Linux data source producing the Argus Monitor shared memory layout from /sys/class/hwmon, /proc/stat and /proc/meminfo.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "hwmon_data_source.h"
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        inline string HwmonDataSource::ReadText(const filesystem::path& path)
+        {
+            const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return "";
+
+            char text[256];
+            const ssize_t length = pread(fd, text, sizeof(text) - 1, 0);
+            close(fd);
+            if (length <= 0) return "";
+
+            string result(text, static_cast<size_t>(length));
+            while (!result.empty() && ('\n' == result.back() || ' ' == result.back())) result.pop_back();
+            return result;
+        }
+
+        // sysfs labels are UTF-8, bytes that do not form a valid sequence are taken as latin-1
+        inline wstring HwmonDataSource::DecodeUtf8(const string& text)
+        {
+            wstring result;
+            result.reserve(text.size());
+            for (size_t index{}; index < text.size();)
+            {
+                const auto lead = static_cast<unsigned char>(text[index]);
+                const size_t length = lead < 0x80 ? 1 : (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : (lead & 0xF8) == 0xF0 ? 4 : 0;
+
+                char32_t code_point = 1 == length ? lead : 2 == length ? lead & 0x1F : 3 == length ? lead & 0x0F : lead & 0x07;
+                bool is_valid = length > 0 && index + length <= text.size();
+                for (size_t continuation{ 1 }; is_valid && continuation < length; ++continuation)
+                {
+                    const auto byte = static_cast<unsigned char>(text[index + continuation]);
+                    is_valid = (byte & 0xC0) == 0x80;
+                    code_point = (code_point << 6) | (byte & 0x3F);
+                }
+
+                if (is_valid)
+                {
+                    result.push_back(static_cast<wchar_t>(code_point));
+                    index += length;
+                }
+                else
+                {
+                    result.push_back(static_cast<wchar_t>(lead));
+                    ++index;
+                }
+            }
+            return result;
+        }
+
+        inline bool HwmonDataSource::ReadFd(const int& fd, size_t& length)
+        {
+            const ssize_t read = pread(fd, buffer.data(), buffer.size() - 1, 0);
+            if (read < 0) return false;
+
+            length = static_cast<size_t>(read);
+            buffer[length] = '\0';
+            return true;
+        }
+
+        inline HwmonDataSource::CHIP_KIND HwmonDataSource::ChipKind(const string& name)
+        {
+            if ("coretemp" == name || "k10temp" == name || "zenpower" == name) return CHIP_KIND_CPU;
+            if ("amdgpu" == name || "radeon" == name || "nouveau" == name || "i915" == name || "xe" == name) return CHIP_KIND_GPU;
+            if ("nvme" == name || "drivetemp" == name) return CHIP_KIND_DRIVE;
+            return CHIP_KIND_MAINBOARD;
+        }
+
+        inline int HwmonDataSource::Open()
+        {
+            if (is_open)
+            {
+                return 0;
+            }
+
+            error_code error;
+            if (!filesystem::is_directory(hwmon_root, error))
+            {
+                return 1;
+            }
+
+            stat_fd = open((proc_root + "/stat").c_str(), O_RDONLY | O_CLOEXEC);
+            if (stat_fd < 0)
+            {
+                Close();
+                return 10;
+            }
+
+            meminfo_fd = open((proc_root + "/meminfo").c_str(), O_RDONLY | O_CLOEXEC);
+            if (meminfo_fd < 0)
+            {
+                Close();
+                return 100;
+            }
+
+            buffer.resize(64U * 1024U);
+            ScanHwmon();
+
+            // the first read only establishes the baseline for the per core load
+            ReadCpuLoads();
+            for (uint32_t core{}; core < cpu_loads.size(); ++core)
+            {
+                sources.push_back({ SOURCE_KIND_CPU_LOAD, SENSOR_TYPE_CPU_LOAD, L"CPU Core " + to_wstring(core), L"%", -1, 1, core, 0, 0 });
+            }
+
+            sources.push_back({ SOURCE_KIND_RAM_TOTAL, SENSOR_TYPE_RAM_USAGE, L"RAM Total", L"MB", -1, 1, 0, 0, 0 });
+            sources.push_back({ SOURCE_KIND_RAM_USED, SENSOR_TYPE_RAM_USAGE, L"RAM Used", L"MB", -1, 1, 0, 0, 0 });
+            sources.push_back({ SOURCE_KIND_RAM_PERCENTAGE, SENSOR_TYPE_RAM_USAGE, L"RAM Usage", L"%", -1, 1, 0, 0, 0 });
+
+            // the shared memory layout groups the sensors by type
+            stable_sort(sources.begin(), sources.end(), [](const SensorSource& a, const SensorSource& b) { return a.sensor_type < b.sensor_type; });
+            while (sources.size() > kMaxSensorCount)
+            {
+                if (SOURCE_KIND_FILE == sources.back().kind) close(sources.back().fd);
+                sources.pop_back();
+            }
+
+            memset(offset_for_sensor_type, 0, sizeof(offset_for_sensor_type));
+            memset(sensor_count, 0, sizeof(sensor_count));
+            for (int sensor_type{ SENSOR_TYPE_MAX_SENSORS - 1 }; sensor_type >= 0; --sensor_type)
+            {
+                offset_for_sensor_type[sensor_type] = static_cast<uint32_t>(sources.size());
+            }
+            for (uint32_t index{ static_cast<uint32_t>(sources.size()) }; index > 0; --index)
+            {
+                const auto& sensor_type = sources[index - 1].sensor_type;
+                offset_for_sensor_type[sensor_type] = index - 1;
+                ++sensor_count[sensor_type];
+            }
+
+            // number the readings of every sensor type and instance
+            for (size_t index{}; index < sources.size(); ++index)
+            {
+                uint32_t data_index{ 0 };
+                for (size_t previous{ offset_for_sensor_type[sources[index].sensor_type] }; previous < index; ++previous)
+                {
+                    if (sources[previous].sensor_index == sources[index].sensor_index) ++data_index;
+                }
+                sources[index].data_index = data_index;
+            }
+
+            cycle_counter = 0;
+
+            is_open = true;
+
+            return 0;
+        }
+
+        inline int HwmonDataSource::Close()
+        {
+            is_open = false;
+
+            int success{ 0 };
+            for (const auto& source : sources)
+            {
+                if (SOURCE_KIND_FILE == source.kind) success |= close(source.fd) == 0 ? 0 : 1;
+            }
+            sources.clear();
+
+            if (stat_fd >= 0)
+            {
+                success |= close(stat_fd) == 0 ? 0 : 10;
+                stat_fd = -1;
+            }
+
+            if (meminfo_fd >= 0)
+            {
+                success |= close(meminfo_fd) == 0 ? 0 : 100;
+                meminfo_fd = -1;
+            }
+
+            last_cpu_times.clear();
+            cpu_loads.clear();
+            return success;
+        }
+
+        inline void HwmonDataSource::ScanHwmon()
+        {
+            error_code error;
+            vector<filesystem::path> chips;
+            for (const auto& entry : filesystem::directory_iterator(hwmon_root, error))
+            {
+                chips.push_back(entry.path());
+            }
+
+            // hwmon2 before hwmon10
+            sort(chips.begin(), chips.end(), [](const filesystem::path& a, const filesystem::path& b)
+            {
+                const auto& a_name = a.filename().string();
+                const auto& b_name = b.filename().string();
+                return a_name.size() != b_name.size() ? a_name.size() < b_name.size() : a_name < b_name;
+            });
+
+            uint32_t chip_count[CHIP_KIND_MAX]{};
+            for (const auto& chip : chips)
+            {
+                const auto& name = ReadText(chip / "name");
+                const auto& kind = ChipKind(name);
+                ScanChip(chip, name, kind, chip_count[kind]++);
+            }
+        }
+
+        inline void HwmonDataSource::ScanChip(const filesystem::path& chip, const string& name, const CHIP_KIND& kind, const uint32_t& sensor_index)
+        {
+            error_code error;
+            vector<pair<string, uint32_t>> channels;    // prefix and channel number of every readable value
+            for (const auto& entry : filesystem::directory_iterator(chip, error))
+            {
+                const auto& file_name = entry.path().filename().string();
+                for (const auto& prefix : { "temp", "fan", "pwm", "power" })
+                {
+                    const size_t prefix_length = strlen(prefix);
+                    if (0 != file_name.compare(0, prefix_length, prefix)) continue;
+
+                    char* suffix;
+                    const unsigned long channel = strtoul(file_name.c_str() + prefix_length, &suffix, 10);
+                    if (suffix == file_name.c_str() + prefix_length) continue;
+
+                    const string suffix_name(suffix);
+                    const bool is_value = "pwm" == string(prefix) ? suffix_name.empty()
+                                        : "power" == string(prefix) ? "_average" == suffix_name || "_input" == suffix_name
+                                        : "_input" == suffix_name;
+                    if (is_value) channels.emplace_back(prefix, static_cast<uint32_t>(channel));
+                }
+            }
+
+            sort(channels.begin(), channels.end());
+            channels.erase(unique(channels.begin(), channels.end()), channels.end());
+
+            for (const auto& channel : channels)
+            {
+                const auto& prefix = channel.first;
+                const auto& number = to_string(channel.second);
+                const auto& label_text = ReadText(chip / (prefix + number + "_label"));
+                const auto& label_name = label_text.empty() ? name + " " + prefix + number : label_text;
+                const wstring label = DecodeUtf8(label_name);
+
+                if ("temp" == prefix)
+                {
+                    ARGUS_MONITOR_SENSOR_TYPE sensor_type;
+                    switch (kind)
+                    {
+                        case CHIP_KIND_CPU:
+                            sensor_type = label_name.starts_with("Tccd") ? SENSOR_TYPE_CPU_TEMPERATURE_ADDITIONAL : SENSOR_TYPE_CPU_TEMPERATURE;
+                            break;
+                        case CHIP_KIND_GPU:
+                            sensor_type = SENSOR_TYPE_GPU_TEMPERATURE;
+                            break;
+                        case CHIP_KIND_DRIVE:
+                            sensor_type = SENSOR_TYPE_DISK_TEMPERATURE;
+                            break;
+                        default:
+                            sensor_type = SENSOR_TYPE_TEMPERATURE;
+                            break;
+                    }
+                    AddFile(chip / (prefix + number + "_input"), sensor_type, label, L"\u00B0C", 0.001, sensor_index); // m°C => °C
+                }
+                else if ("fan" == prefix)
+                {
+                    AddFile(chip / (prefix + number + "_input"), CHIP_KIND_GPU == kind ? SENSOR_TYPE_GPU_FAN_SPEED_RPM : SENSOR_TYPE_FAN_SPEED_RPM, label, L"rpm", 1, sensor_index);
+                }
+                else if ("pwm" == prefix)
+                {
+                    AddFile(chip / (prefix + number), CHIP_KIND_GPU == kind ? SENSOR_TYPE_GPU_FAN_SPEED_PERCENT : SENSOR_TYPE_FAN_CONTROL_VALUE, label, L"%", 100.0 / 255, sensor_index); // 0-255 => %
+                }
+                else if ("power" == prefix && CHIP_KIND_GPU == kind)
+                {
+                    // prefer the averaged reading over the instantaneous one
+                    const auto& average = chip / (prefix + number + "_average");
+                    AddFile(filesystem::exists(average, error) ? average : chip / (prefix + number + "_input"), SENSOR_TYPE_GPU_POWER, label, L"W", 0.000001, sensor_index); // uW => W
+                }
+            }
+        }
+
+        inline void HwmonDataSource::AddFile(const filesystem::path& path,
+                                             const ARGUS_MONITOR_SENSOR_TYPE& sensor_type,
+                                             const wstring& label,
+                                             const wchar_t* unit,
+                                             const double& scale,
+                                             const uint32_t& sensor_index)
+        {
+            const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return;
+
+            sources.push_back({ SOURCE_KIND_FILE, sensor_type, label, unit, fd, scale, 0, sensor_index, 0 });
+        }
+
+        inline void HwmonDataSource::ReadCpuLoads()
+        {
+            size_t length;
+            if (!ReadFd(stat_fd, length)) return;
+
+            // cpuN user nice system idle iowait irq softirq steal ...
+            for (const char* line = buffer.data(); line < buffer.data() + length && 0 == strncmp(line, "cpu", 3); line = strchr(line, '\n') + 1)
+            {
+                // the aggregated "cpu " line is skipped, only the per core lines are used
+                if (isdigit(static_cast<unsigned char>(line[3])))
+                {
+                    char* end;
+                    const unsigned long core = strtoul(line + 3, &end, 10);
+                    uint64_t times[8]{};
+                    for (auto& time : times) time = strtoull(end, &end, 10);
+
+                    CpuTimes current;
+                    for (const auto& time : times) current.total += time;
+                    current.busy = current.total - times[3] - times[4];
+
+                    if (core >= last_cpu_times.size())
+                    {
+                        last_cpu_times.resize(core + 1);
+                        cpu_loads.resize(core + 1, 0);
+                    }
+
+                    const auto& last = last_cpu_times[core];
+                    const uint64_t total = current.total - last.total;
+                    cpu_loads[core] = 0 != last.total && total > 0 ? 100.0 * (current.busy - last.busy) / total : 0;
+                    last_cpu_times[core] = current;
+                }
+
+                if (nullptr == strchr(line, '\n')) break;
+            }
+        }
+
+        inline void HwmonDataSource::Sample(ArgusMonitorData& data)
+        {
+            if (!is_open)
+            {
+                data.Signature = 0;
+                data.TotalSensorCount = 0;
+                return;
+            }
+
+            ReadCpuLoads();
+
+            uint64_t memory_total{ 0 };
+            uint64_t memory_available{ 0 };
+            size_t length;
+            if (ReadFd(meminfo_fd, length))
+            {
+                if (const char* total = strstr(buffer.data(), "MemTotal:")) memory_total = strtoull(total + 9, nullptr, 10);
+                if (const char* available = strstr(buffer.data(), "MemAvailable:")) memory_available = strtoull(available + 13, nullptr, 10);
+            }
+            const uint64_t memory_used = memory_total > memory_available ? memory_total - memory_available : 0;
+
+            for (size_t index{}; index < sources.size(); ++index)
+            {
+                const auto& source = sources[index];
+                double value{ 0 };
+                switch (source.kind)
+                {
+                    case SOURCE_KIND_FILE:
+                        if (ReadFd(source.fd, length) && length > 0) value = strtod(buffer.data(), nullptr) * source.scale;
+                        break;
+                    case SOURCE_KIND_CPU_LOAD:
+                        value = source.core < cpu_loads.size() ? cpu_loads[source.core] : 0;
+                        break;
+                    case SOURCE_KIND_RAM_TOTAL:
+                        value = memory_total * 1024.0 / 1000000; // KiB => MB
+                        break;
+                    case SOURCE_KIND_RAM_USED:
+                        value = memory_used * 1024.0 / 1000000; // KiB => MB
+                        break;
+                    case SOURCE_KIND_RAM_PERCENTAGE:
+                        value = memory_total > 0 ? 100.0 * memory_used / memory_total : 0;
+                        break;
+                }
+
+                auto& sensor_data = data.SensorData[index];
+                sensor_data.SensorType = source.sensor_type;
+                wcsncpy(sensor_data.Label, source.label.c_str(), kMaxLenLabel - 1);
+                sensor_data.Label[kMaxLenLabel - 1] = L'\0';
+                wcsncpy(sensor_data.UnitString, source.unit.c_str(), kMaxLenUnit - 1);
+                sensor_data.UnitString[kMaxLenUnit - 1] = L'\0';
+                sensor_data.Value = value;
+                sensor_data.DataIndex = source.data_index;
+                sensor_data.SensorIndex = source.sensor_index;
+            }
+
+            data.ArgusMajor = 0;
+            data.ArgusMinorA = 0;
+            data.ArgusMinorB = 0;
+            data.ArgusExtra = 0;
+            data.ArgusBuild = 0;
+            data.Version = 1;
+            memcpy(data.OffsetForSensorType, offset_for_sensor_type, sizeof(offset_for_sensor_type));
+            memcpy(data.SensorCount, sensor_count, sizeof(sensor_count));
+            data.TotalSensorCount = static_cast<uint32_t>(sources.size());
+            data.Signature = 0x4D677241;
+
+            // 0 is invalid, see ArgusMonitorData::CycleCounter
+            if (0 == ++cycle_counter) ++cycle_counter;
+            data.CycleCounter = cycle_counter;
+        }
+    }
+}
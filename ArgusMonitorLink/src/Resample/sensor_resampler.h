@@ -0,0 +1,82 @@
+/**
+Resampling of the published sensor values onto a fixed timeline, decoupled from the irregular Argus Monitor cycle timing.
+Only the last two observed cycles are kept per sensor, ticks are computed incrementally whenever batches are requested.
+Sensors missing from the latest observed cycle are not carried past their last observation, their windows are dropped once they stay stale.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        enum RESAMPLE_POLICY
+        {
+            RESAMPLE_POLICY_LAST_VALUE = 0,    // hold the last observed value, ticks are delivered up to the current time
+            RESAMPLE_POLICY_LINEAR,            // interpolate between the observed cycles, ticks are delivered up to the last observed cycle
+            RESAMPLE_POLICY_MAX
+        };
+
+        class SensorResampler
+        {
+        private:
+            struct SensorWindow
+            {
+                bool     has_previous    { false };
+                uint64_t previous_time_ms{ 0 };
+                float    previous_value  { 0 };
+                uint64_t time_ms         { 0 };
+                float    value           { 0 };
+                uint64_t sequence        { 0 };    // observed cycle of the last value
+            };
+
+            // older ticks are dropped if batches were not requested for a long time
+            static constexpr uint64_t kMaxBacklogTicks = 240;
+            // a value is not held for more ticks than this past its observation
+            static constexpr uint64_t kMaxStaleTicks = 16;
+
+            uint64_t                    interval_ms  { 0 };
+            RESAMPLE_POLICY             policy       { RESAMPLE_POLICY_LAST_VALUE };
+            uint64_t                    next_tick_ms { 0 };
+            uint64_t                    last_time_ms { 0 };
+            uint64_t                    last_sequence{ 0 };
+            map<const string, uint32_t> slots;
+            vector<string>              sensor_ids;
+            vector<SensorWindow>        windows;
+            vector<const char*>         batch_ids;
+            vector<float>               batch_values;
+
+            bool ValueAt(const SensorWindow& window, const uint64_t& tick_ms, float& value) const;
+            void DropStaleWindows();
+
+        public:
+            // an interval of 0 disables the resampling, reconfiguring drops all collected windows
+            void Configure(const uint64_t& interval_ms, const RESAMPLE_POLICY& policy);
+
+            inline bool IsEnabled() const noexcept { return interval_ms > 0; }
+
+            // sequence numbers the observed cycles, a sensor skipping a cycle starts a new window
+            void Observe(const string& sensor_id, const uint64_t& timestamp_ms, const float& value, const uint64_t& sequence);
+
+            // deliver one batch per tick that became due, now_ms only matters for RESAMPLE_POLICY_LAST_VALUE
+            // returns the amount of delivered batches
+            uint32_t Deliver(const uint64_t& now_ms,
+                             void (deliver)(const uint64_t timestamp_ms,
+                                            const uint32_t count,
+                                            const char* const* sensor_ids,
+                                            const float* values));
+        };
+    }
+}
+
+#include "sensor_resampler.inl"
@@ -0,0 +1,150 @@
+/**
+Resampling of the published sensor values onto a fixed timeline, decoupled from the irregular Argus Monitor cycle timing.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "sensor_resampler.h"
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        inline void SensorResampler::Configure(const uint64_t& interval_ms, const RESAMPLE_POLICY& policy)
+        {
+            this->interval_ms = interval_ms;
+            this->policy = policy;
+            next_tick_ms = 0;
+            last_time_ms = 0;
+            last_sequence = 0;
+            slots.clear();
+            sensor_ids.clear();
+            windows.clear();
+            batch_ids.clear();
+            batch_values.clear();
+        }
+
+        inline void SensorResampler::Observe(const string& sensor_id, const uint64_t& timestamp_ms, const float& value, const uint64_t& sequence)
+        {
+            // try_emplace only copies the id if the sensor is new
+            const auto& slot = slots.try_emplace(sensor_id, static_cast<uint32_t>(windows.size()));
+            if (slot.second)
+            {
+                sensor_ids.push_back(sensor_id);
+                windows.emplace_back();
+            }
+
+            auto& window = windows[slot.first->second];
+            // never interpolate across cycles the sensor was absent from
+            window.has_previous = window.time_ms > 0 && window.sequence + 1 == sequence && window.time_ms < timestamp_ms;
+            if (window.has_previous)
+            {
+                window.previous_time_ms = window.time_ms;
+                window.previous_value = window.value;
+            }
+            window.time_ms = timestamp_ms;
+            window.value = value;
+            window.sequence = sequence;
+
+            // the timeline starts at the first tick after the first observation
+            if (0 == next_tick_ms) next_tick_ms = (timestamp_ms / interval_ms + 1) * interval_ms;
+            if (sequence > last_sequence)
+            {
+                last_sequence = sequence;
+                last_time_ms = timestamp_ms;
+            }
+        }
+
+        inline bool SensorResampler::ValueAt(const SensorWindow& window, const uint64_t& tick_ms, float& value) const
+        {
+            if (tick_ms >= window.time_ms)
+            {
+                // sensors missing from the latest cycle end at their last observation, present ones are held for a bounded time
+                if (tick_ms > window.time_ms && (window.sequence != last_sequence || tick_ms - window.time_ms > kMaxStaleTicks * interval_ms)) return false;
+
+                value = window.value;
+                return true;
+            }
+
+            if (!window.has_previous || tick_ms < window.previous_time_ms) return false;
+
+            if (RESAMPLE_POLICY_LINEAR == policy)
+            {
+                const float position = static_cast<float>(tick_ms - window.previous_time_ms) / (window.time_ms - window.previous_time_ms);
+                value = window.previous_value + (window.value - window.previous_value) * position;
+            }
+            else
+            {
+                value = window.previous_value;
+            }
+            return true;
+        }
+
+        inline uint32_t SensorResampler::Deliver(const uint64_t& now_ms,
+                                                 void (deliver)(const uint64_t timestamp_ms,
+                                                                const uint32_t count,
+                                                                const char* const* sensor_ids,
+                                                                const float* values))
+        {
+            if (!IsEnabled() || 0 == next_tick_ms) return 0;
+
+            const uint64_t until_ms = RESAMPLE_POLICY_LINEAR == policy ? last_time_ms : now_ms;
+            if (until_ms >= next_tick_ms + kMaxBacklogTicks * interval_ms)
+            {
+                next_tick_ms += ((until_ms - next_tick_ms) / interval_ms - kMaxBacklogTicks + 1) * interval_ms;
+            }
+
+            uint32_t delivered{ 0 };
+            for (; next_tick_ms <= until_ms; next_tick_ms += interval_ms)
+            {
+                batch_ids.clear();
+                batch_values.clear();
+                for (size_t slot{}; slot < windows.size(); ++slot)
+                {
+                    float value;
+                    if (ValueAt(windows[slot], next_tick_ms, value))
+                    {
+                        batch_ids.push_back(sensor_ids[slot].c_str());
+                        batch_values.push_back(value);
+                    }
+                }
+
+                deliver(next_tick_ms, static_cast<uint32_t>(batch_ids.size()), batch_ids.data(), batch_values.data());
+                ++delivered;
+            }
+
+            DropStaleWindows();
+            return delivered;
+        }
+
+        inline void SensorResampler::DropStaleWindows()
+        {
+            // windows of sensors that disappeared and will not reach any further tick
+            const auto& is_dead = [this](const SensorWindow& window)
+            {
+                return window.sequence != last_sequence && window.time_ms + kMaxStaleTicks * interval_ms < next_tick_ms;
+            };
+            if (none_of(windows.begin(), windows.end(), is_dead)) return;
+
+            size_t kept{ 0 };
+            for (size_t slot{}; slot < windows.size(); ++slot)
+            {
+                if (is_dead(windows[slot]))
+                {
+                    slots.erase(sensor_ids[slot]);
+                    continue;
+                }
+                if (kept != slot)
+                {
+                    windows[kept] = windows[slot];
+                    sensor_ids[kept] = move(sensor_ids[slot]);
+                    slots[sensor_ids[kept]] = static_cast<uint32_t>(kept);
+                }
+                ++kept;
+            }
+            windows.resize(kept);
+            sensor_ids.resize(kept);
+        }
+    }
+}
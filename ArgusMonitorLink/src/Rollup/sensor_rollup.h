@@ -0,0 +1,94 @@
+/**
+Multi-resolution rollups (raw / 1s / 1m / 1h) of the sensor values published by ArgusMonitorLink.
+Every tier is a ring per sensor that grows on demand up to a fixed capacity, so memory stays bounded no matter the uptime.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        enum ROLLUP_TIER
+        {
+            ROLLUP_TIER_RAW = 0,    // every observed sample
+            ROLLUP_TIER_SECOND,     // 1 second buckets
+            ROLLUP_TIER_MINUTE,     // 1 minute buckets
+            ROLLUP_TIER_HOUR,       // 1 hour buckets
+            ROLLUP_TIER_MAX
+        };
+
+        // bucket width in milliseconds, 0 means every sample gets its own bucket
+        const uint64_t kRollupTierWidth[ROLLUP_TIER_MAX]    = { 0U, 1000U, 60U * 1000U, 60U * 60U * 1000U };
+        // number of buckets kept per sensor: ~1 minute raw, 5 minutes of seconds, 24 hours of minutes, 7 days of hours
+        const uint32_t kRollupTierCapacity[ROLLUP_TIER_MAX] = { 60U, 300U, 1440U, 168U };
+
+        struct RollupBucket
+        {
+            uint64_t start_ms;    // start of the bucket, see NowMilliseconds()
+            float    min;
+            float    max;
+            double   sum;
+            uint32_t count;
+        };
+
+        class RollupRing
+        {
+        private:
+            vector<RollupBucket> buckets;     // grows until it holds capacity buckets, then wraps around
+            uint32_t             capacity{ 0 };
+            uint32_t             newest  { 0 };
+
+        public:
+            explicit RollupRing(const uint32_t& capacity) : capacity{ capacity } {}
+
+            void Add(const uint64_t& width_ms, const uint64_t& timestamp_ms, const float& value);
+
+            inline uint32_t Size() const noexcept { return static_cast<uint32_t>(buckets.size()); }
+            inline bool     IsFull() const noexcept { return buckets.size() == capacity; }
+            // index 0 is the oldest bucket
+            inline const RollupBucket& At(const uint32_t& index) const { return buckets[(newest + 1 + index) % buckets.size()]; }
+        };
+
+        class SensorRollup
+        {
+        private:
+            vector<RollupRing> tiers;
+
+        public:
+            SensorRollup();
+
+            void Record(const uint64_t& timestamp_ms, const float& value);
+            int  SelectTier(const uint64_t& now_ms, const uint64_t& range_ms, const uint64_t& resolution_ms) const;
+
+            inline const RollupRing& Tier(const int& tier) const { return tiers[tier]; }
+        };
+
+        class RollupStore
+        {
+        private:
+            map<const string, SensorRollup> sensors;
+
+        public:
+            inline void Record(const string& sensor_id, const uint64_t& timestamp_ms, const float& value) { sensors[sensor_id].Record(timestamp_ms, value); }
+            inline void Clear() { sensors.clear(); }
+
+            inline const SensorRollup* Find(const string& sensor_id) const {
+                const auto& sensor = sensors.find(sensor_id);
+                return sensors.end() == sensor ? nullptr : &sensor->second;
+            }
+        };
+    }
+}
+
+#include "sensor_rollup.inl"
@@ -0,0 +1,78 @@
+/**
+Multi-resolution rollups (raw / 1s / 1m / 1h) of the sensor values published by ArgusMonitorLink.
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "sensor_rollup.h"
+
+namespace argus_monitor
+{
+    namespace data_api
+    {
+        // merge the value into the newest bucket if it still covers the timestamp, otherwise overwrite the oldest one
+        inline void RollupRing::Add(const uint64_t& width_ms, const uint64_t& timestamp_ms, const float& value)
+        {
+            const uint64_t start_ms = width_ms > 0 ? timestamp_ms - timestamp_ms % width_ms : timestamp_ms;
+
+            if (!buckets.empty() && width_ms > 0 && buckets[newest].start_ms == start_ms)
+            {
+                auto& bucket = buckets[newest];
+                if (value < bucket.min) bucket.min = value;
+                if (value > bucket.max) bucket.max = value;
+                bucket.sum += value;
+                ++bucket.count;
+                return;
+            }
+
+            if (IsFull())
+            {
+                newest = (newest + 1) % capacity;
+                buckets[newest] = { start_ms, value, value, value, 1 };
+                return;
+            }
+
+            // grow geometrically but never reserve more than the capacity of the tier
+            if (buckets.size() == buckets.capacity()) buckets.reserve(min<size_t>(capacity, max<size_t>(8, buckets.size() * 2)));
+            buckets.push_back({ start_ms, value, value, value, 1 });
+            newest = static_cast<uint32_t>(buckets.size()) - 1;
+        }
+
+        inline SensorRollup::SensorRollup()
+        {
+            tiers.reserve(ROLLUP_TIER_MAX);
+            for (int tier{}; tier < ROLLUP_TIER_MAX; ++tier)
+            {
+                tiers.emplace_back(kRollupTierCapacity[tier]);
+            }
+        }
+
+        inline void SensorRollup::Record(const uint64_t& timestamp_ms, const float& value)
+        {
+            for (int tier{}; tier < ROLLUP_TIER_MAX; ++tier)
+            {
+                tiers[tier].Add(kRollupTierWidth[tier], timestamp_ms, value);
+            }
+        }
+
+        // pick the coarsest tier that is at least as fine as the requested resolution and still covers the requested range
+        // if no tier covers the range, the coarsest tier matching the resolution is used since it reaches back the furthest
+        inline int SensorRollup::SelectTier(const uint64_t& now_ms, const uint64_t& range_ms, const uint64_t& resolution_ms) const
+        {
+            int fallback{ -1 };
+            for (int tier{ ROLLUP_TIER_MAX - 1 }; tier >= ROLLUP_TIER_RAW; --tier)
+            {
+                if (kRollupTierWidth[tier] > resolution_ms) continue;
+
+                const auto& ring = tiers[tier];
+                if (0 == ring.Size()) continue;
+                if (-1 == fallback) fallback = tier;
+
+                // a ring that has not wrapped yet still holds the complete history
+                if (!ring.IsFull() || now_ms - ring.At(0).start_ms >= range_ms) return tier;
+            }
+            return fallback;
+        }
+    }
+}
@@ -8,6 +8,8 @@ Original License from https://github.com/argotronic/argus_data_api still applies
 #pragma once
 #include "../ArgusMonitor/argus_monitor_data_api.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <numeric>
 #include <regex>
 #include <string>
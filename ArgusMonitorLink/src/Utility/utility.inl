@@ -193,3 +193,8 @@ inline const float GetFloatValue(const float& value, const string& sensor_type)
 inline const string SensorId(const string& hardware_type, const string& sensor_type, const string& sensor_group, const int& sensor_index, const int& data_index) {
     return hardware_type + "_" + sensor_type + "_" + sensor_group + "_" + to_string(sensor_index) + "_" + to_string(data_index);
 }
+
+// milliseconds on a monotonic clock, used to timestamp the observed cycles
+inline const uint64_t NowMilliseconds() {
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+}
@@ -50,6 +50,7 @@ namespace argus_monitor
             }
 
             last_cycle_counter = 0;
+            integrators.Restart();
 
             is_open = true;
 
@@ -77,6 +78,9 @@ namespace argus_monitor
             {
                 mutex_handle = nullptr;
             }
+
+            layout.Reset();
+            lookup_layout.Reset();
             return success;
         }
 
@@ -136,6 +140,23 @@ namespace argus_monitor
             map<uint32_t, map<string, float>> multipliers;
 
             last_cycle_counter = argus_monitor_data->CycleCounter;
+            last_cycle_time = NowMilliseconds();
+            ++observed_cycles;
+
+            // bind against the internal layout, the exported metadata table must not change during polling
+            if (histograms_enabled)
+            {
+                lookup_layout.Verify(*argus_monitor_data);
+                histograms.Bind(lookup_layout);
+            }
+
+            // pass the value on and feed the link side aggregations
+            const auto& publish = [&](const string& sensor_id, const float& value)
+            {
+                update(sensor_id.c_str(), value);
+                if (rollups_enabled) rollups.Record(sensor_id, last_cycle_time, value);
+                if (resampler.IsEnabled()) resampler.Observe(sensor_id, last_cycle_time, value, observed_cycles);
+            };
 
             for (size_t index{}; index < argus_monitor_data->TotalSensorCount; ++index)
             {
@@ -178,12 +199,41 @@ namespace argus_monitor
                             }
                         }
 
-                        update(SensorId(hardware_type,
-                                        sensor_type,
-                                        sensor_group,
-                                        sensor_index,
-                                        data_index).c_str(),
-                               value);
+                        if (histograms_enabled) histograms.Record(index, value, last_cycle_time, observed_cycles);
+
+                        const auto& sensor_id = SensorId(hardware_type,
+                                                         sensor_type,
+                                                         sensor_group,
+                                                         sensor_index,
+                                                         data_index);
+                        publish(sensor_id, value);
+
+                        if (integrators_enabled)
+                        {
+                            const auto& accumulator = integrators.Observe(sensor_id, sensor_data.SensorType, sensor_data.Value, value, last_cycle_time, observed_cycles);
+                            if (nullptr != accumulator)
+                            {
+                                if (accumulator->is_integrated)
+                                {
+                                    publish(SensorId(hardware_type,
+                                                     SensorIntegrator::IntegratedSensorType(sensor_data.SensorType),
+                                                     sensor_group,
+                                                     sensor_index,
+                                                     data_index),
+                                            static_cast<float>(accumulator->total));
+                                }
+
+                                if (accumulator->has_threshold)
+                                {
+                                    publish(SensorId(hardware_type,
+                                                     "Duration",
+                                                     string(sensor_group) + "_Above",
+                                                     sensor_index,
+                                                     data_index),
+                                            static_cast<float>(accumulator->seconds_above));
+                                }
+                            }
+                        }
                     }
                 }
             }
@@ -205,17 +255,17 @@ namespace argus_monitor
                             if (value.second > max_multiplier) max_multiplier = value.second;
                             sum_multiplier += value.second;
 
-                            update(value.first.c_str(), value.second * fsb_clock.second);
+                            publish(value.first, value.second * fsb_clock.second);
                         }
                         const float& average_multiplier = sum_multiplier / multiplier_size;
 
                         const auto& id = to_string(fsb_clock.first);
-                        update(("CPU_Multiplier_Multiplier_Max_" + id).c_str(), max_multiplier);
-                        update(("CPU_Frequency_Core_Clock_Max_" + id).c_str(), max_multiplier * fsb_clock.second);
-                        update(("CPU_Multiplier_Multiplier_Average_" + id).c_str(), average_multiplier);
-                        update(("CPU_Frequency_Core_Clock_Average_" + id).c_str(), average_multiplier * fsb_clock.second);
-                        update(("CPU_Multiplier_Multiplier_Min_" + id).c_str(), min_multiplier);
-                        update(("CPU_Frequency_Core_Clock_Min_" + id).c_str(), min_multiplier * fsb_clock.second);
+                        publish("CPU_Multiplier_Multiplier_Max_" + id, max_multiplier);
+                        publish("CPU_Frequency_Core_Clock_Max_" + id, max_multiplier * fsb_clock.second);
+                        publish("CPU_Multiplier_Multiplier_Average_" + id, average_multiplier);
+                        publish("CPU_Frequency_Core_Clock_Average_" + id, average_multiplier * fsb_clock.second);
+                        publish("CPU_Multiplier_Multiplier_Min_" + id, min_multiplier);
+                        publish("CPU_Frequency_Core_Clock_Min_" + id, min_multiplier * fsb_clock.second);
                     }
                 }
             }
@@ -237,13 +287,163 @@ namespace argus_monitor
                         }
 
                         const auto& id = to_string(cpu_temp.first);
-                        update(("CPU_Temperature_Temperature_Max_" + id).c_str(), max_temp);
-                        update(("CPU_Temperature_Temperature_Average_" + id).c_str(), sum_temp / cpu_temp.second.size());
-                        update(("CPU_Temperature_Temperature_Min_" + id).c_str(), min_temp);
+                        publish("CPU_Temperature_Temperature_Max_" + id, max_temp);
+                        publish("CPU_Temperature_Temperature_Average_" + id, sum_temp / cpu_temp.second.size());
+                        publish("CPU_Temperature_Temperature_Min_" + id, min_temp);
                     }
                 }
             }
             return true;
         }
+
+        uint32_t ArgusMonitorLink::UpdateResampledSensorData(void (deliver)(const uint64_t timestamp_ms,
+                                                                            const uint32_t count,
+                                                                            const char* const* sensor_ids,
+                                                                            const float* values))
+        {
+            if (!resampler.IsEnabled()) return 0;
+
+            // the values reach the resampler through the aggregations of UpdateSensorData
+            UpdateSensorData([](const char*, const float) {});
+            return resampler.Deliver(NowMilliseconds(), deliver);
+        }
+
+        uint32_t ArgusMonitorLink::GetSensorMetadataTable(const SensorMetadataRecord*& records,
+                                                          uint32_t& record_count,
+                                                          const char*& string_pool,
+                                                          uint32_t& string_pool_size)
+        {
+            Lock scoped_lock(mutex_handle);
+
+            layout.Refresh(*argus_monitor_data);
+
+            records = layout.Records().data();
+            record_count = static_cast<uint32_t>(layout.Records().size());
+            string_pool = layout.StringPool().data();
+            string_pool_size = static_cast<uint32_t>(layout.StringPool().size());
+            return layout.Generation();
+        }
+
+        SensorSnapshot ArgusMonitorLink::Snapshot() const
+        {
+            Lock scoped_lock(mutex_handle);
+
+            vector<bool> enabled;
+            enabled.reserve(argus_monitor_data->TotalSensorCount);
+            for (size_t index{}; index < argus_monitor_data->TotalSensorCount; ++index)
+            {
+                // the hardware type does not depend on the name, so the label does not need to be decoded here
+                const char* hardware_type;
+                const char* sensor_type;
+                const char* sensor_group;
+                ParseTypes(argus_monitor_data->SensorData[index].SensorType, "", hardware_type, sensor_type, sensor_group);
+                enabled.push_back(IsHardwareEnabled(hardware_type));
+            }
+
+            return SensorSnapshot(*argus_monitor_data, std::move(enabled));
+        }
+
+        uint32_t ArgusMonitorLink::FindSensorHandle(const string_view& sensor_id)
+        {
+            if (!lookup_layout.HasSameHeader(*argus_monitor_data)) lookup_layout.Verify(*argus_monitor_data);
+
+            // a sensor can be swapped in place without changing the header, so verify the entry and only then fall back to the full check,
+            // which runs at most once per cycle, a miss on a layout verified in this cycle is a plain miss
+            const uint32_t handle = lookup_layout.FindHandle(sensor_id);
+            if (PerfectHash::kNotFound != handle && lookup_layout.Matches(*argus_monitor_data, handle)) return handle;
+
+            return lookup_layout.Verify(*argus_monitor_data) ? lookup_layout.FindHandle(sensor_id) : PerfectHash::kNotFound;
+        }
+
+        bool ArgusMonitorLink::GetSensorValue(const string_view& sensor_id, float& value)
+        {
+            Lock scoped_lock(mutex_handle);
+
+            const uint32_t handle = FindSensorHandle(sensor_id);
+            if (PerfectHash::kNotFound == handle) return false;
+
+            value = GetFloatValue(argus_monitor_data->SensorData[handle].Value, lookup_layout.String(lookup_layout.Records()[handle].SensorTypeOffset));
+            return true;
+        }
+
+        uint32_t ArgusMonitorLink::GetSensorValues(const char* const* sensor_ids, float* values, const uint32_t& count)
+        {
+            Lock scoped_lock(mutex_handle);
+
+            uint32_t found{ 0 };
+            for (uint32_t index{}; index < count; ++index)
+            {
+                const uint32_t handle = FindSensorHandle(sensor_ids[index]);
+                if (PerfectHash::kNotFound == handle)
+                {
+                    values[index] = numeric_limits<float>::quiet_NaN();
+                    continue;
+                }
+
+                values[index] = GetFloatValue(argus_monitor_data->SensorData[handle].Value, lookup_layout.String(lookup_layout.Records()[handle].SensorTypeOffset));
+                ++found;
+            }
+            return found;
+        }
+
+        bool ArgusMonitorLink::GetSensorPercentiles(const string& sensor_id, const double* quantiles, float* values, const uint32_t& count) const
+        {
+            const auto& histogram = histograms.Find(sensor_id);
+            if (nullptr == histogram) return false;
+
+            for (uint32_t index{}; index < count; ++index)
+            {
+                values[index] = histogram->Percentile(quantiles[index]);
+            }
+            return true;
+        }
+
+        bool ArgusMonitorLink::GetSensorFractionAbove(const string& sensor_id, const float& threshold, double& fraction) const
+        {
+            const auto& histogram = histograms.Find(sensor_id);
+            if (nullptr == histogram) return false;
+
+            fraction = histogram->FractionAbove(threshold);
+            return true;
+        }
+
+        uint32_t ArgusMonitorLink::GetSensorHistogram(const string& sensor_id, const uint64_t*& durations_ms, const float*& lower_bounds, uint64_t& total_ms) const
+        {
+            const auto& histogram = histograms.Find(sensor_id);
+            if (nullptr == histogram) return 0;
+
+            durations_ms = histogram->Durations().data();
+            lower_bounds = SensorHistogram::LowerBounds(histogram->Scale()).data();
+            total_ms = histogram->TotalMilliseconds();
+            return static_cast<uint32_t>(histogram->Durations().size());
+        }
+
+        int ArgusMonitorLink::QueryRollups(const string& sensor_id,
+                                           const uint64_t& range_ms,
+                                           const uint64_t& resolution_ms,
+                                           void (process_bucket)(const uint64_t start_ms,
+                                                                 const float min,
+                                                                 const float max,
+                                                                 const float average,
+                                                                 const uint32_t count)) const
+        {
+            const auto& sensor_rollup = rollups.Find(sensor_id);
+            if (nullptr == sensor_rollup) return -1;
+
+            const uint64_t now_ms = NowMilliseconds();
+            const int tier = sensor_rollup->SelectTier(now_ms, range_ms, resolution_ms);
+            if (-1 == tier) return -1;
+
+            const auto& ring = sensor_rollup->Tier(tier);
+            for (uint32_t index{}; index < ring.Size(); ++index)
+            {
+                const auto& bucket = ring.At(index);
+                // keep buckets that overlap the requested range
+                if (now_ms - bucket.start_ms > range_ms + kRollupTierWidth[tier]) continue;
+
+                process_bucket(bucket.start_ms, bucket.min, bucket.max, static_cast<float>(bucket.sum / bucket.count), bucket.count);
+            }
+            return tier;
+        }
     }
 }
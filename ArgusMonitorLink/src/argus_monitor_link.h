@@ -10,15 +10,23 @@ Original License from https://github.com/argotronic/argus_data_api still applies
 
 #include "ArgusMonitor/argus_monitor_data_api.h"
 #include "dll/pch.h"
+#include "Histogram/sensor_histogram.h"
+#include "Integrator/sensor_integrator.h"
+#include "Iteration/sensor_snapshot.h"
+#include "Layout/sensor_layout.h"
+#include "Resample/sensor_resampler.h"
+#include "Rollup/sensor_rollup.h"
 #include "utility/utility.h"
 #include "Version/version.h"
 #include <algorithm>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace std;
@@ -53,6 +61,22 @@ namespace argus_monitor
             HANDLE                                           mutex_handle        { nullptr };
             const ArgusMonitorData*                          argus_monitor_data  { nullptr };
             uint32_t                                         last_cycle_counter  { 0 };
+            uint64_t                                         last_cycle_time     { 0 };
+            uint64_t                                         observed_cycles     { 0 };
+
+            SensorLayout                                     layout;              // only rebuilt by GetSensorMetadataTable, its buffers are handed out
+            SensorLayout                                     lookup_layout;       // used by the link internally, rebuilt whenever needed
+
+            bool                                             histograms_enabled  { false };
+            HistogramStore                                   histograms;
+
+            bool                                             integrators_enabled { false };
+            SensorIntegrator                                 integrators;
+
+            bool                                             rollups_enabled     { false };
+            RollupStore                                      rollups;
+
+            SensorResampler                                  resampler;
 
             map<const string, bool> enabled_hardware = {
                 {"CPU", true},
@@ -66,6 +90,8 @@ namespace argus_monitor
                 {"ArgusMonitor", true}
             };
 
+            uint32_t FindSensorHandle(const string_view& sensor_id);
+
             static inline HANDLE OpenArgusApiMutex() { return OpenMutexW(READ_CONTROL | MUTANT_QUERY_STATE | SYNCHRONIZE, FALSE, kMutexName()); }
         public:
             ArgusMonitorLink() = default;
@@ -91,6 +117,60 @@ namespace argus_monitor
                                                           const char* sensor_index,
                                                           const char* data_index));
             bool UpdateSensorData(void (update)(const char* sensor_id, const float sensor_value));
+            uint32_t UpdateResampledSensorData(void (deliver)(const uint64_t timestamp_ms,
+                                                              const uint32_t count,
+                                                              const char* const* sensor_ids,
+                                                              const float* values));
+
+            uint32_t GetSensorMetadataTable(const SensorMetadataRecord*& records,
+                                            uint32_t& record_count,
+                                            const char*& string_pool,
+                                            uint32_t& string_pool_size);
+
+            // capture the raw sensor entries, the returned range decodes them lazily without holding the Argus Monitor mutex
+            SensorSnapshot Snapshot() const;
+
+            bool     GetSensorValue(const string_view& sensor_id, float& value);
+            uint32_t GetSensorValues(const char* const* sensor_ids, float* values, const uint32_t& count);
+
+            int  QueryRollups(const string& sensor_id,
+                              const uint64_t& range_ms,
+                              const uint64_t& resolution_ms,
+                              void (process_bucket)(const uint64_t start_ms,
+                                                    const float min,
+                                                    const float max,
+                                                    const float average,
+                                                    const uint32_t count)) const;
+
+            bool     GetSensorPercentiles(const string& sensor_id, const double* quantiles, float* values, const uint32_t& count) const;
+            bool     GetSensorFractionAbove(const string& sensor_id, const float& threshold, double& fraction) const;
+            uint32_t GetSensorHistogram(const string& sensor_id, const uint64_t*& durations_ms, const float*& lower_bounds, uint64_t& total_ms) const;
+
+            inline void SetHistogramsEnabled(const bool& enabled) {
+                histograms_enabled = enabled;
+                if (!enabled) histograms.Clear();
+            }
+            inline bool IsHistogramsEnabled() const noexcept { return histograms_enabled; }
+
+            inline void SetIntegratorsEnabled(const bool& enabled) {
+                integrators_enabled = enabled;
+                if (!enabled) integrators.Reset();
+            }
+            inline bool IsIntegratorsEnabled() const noexcept { return integrators_enabled; }
+            inline void ResetIntegrators() { integrators.Reset(); }
+            inline void SetSensorThreshold(const string& sensor_id, const float& threshold) { integrators.SetThreshold(sensor_id, threshold); }
+            inline void ClearSensorThreshold(const string& sensor_id) { integrators.ClearThreshold(sensor_id); }
+
+            inline void SetResampling(const uint64_t& interval_ms, const int& policy) {
+                resampler.Configure(interval_ms, RESAMPLE_POLICY_LINEAR == policy ? RESAMPLE_POLICY_LINEAR : RESAMPLE_POLICY_LAST_VALUE);
+            }
+            inline bool IsResamplingEnabled() const noexcept { return resampler.IsEnabled(); }
+
+            inline void SetRollupsEnabled(const bool& enabled) {
+                rollups_enabled = enabled;
+                if (!enabled) rollups.Clear();
+            }
+            inline bool IsRollupsEnabled() const noexcept { return rollups_enabled; }
 
             inline void SetHardwareEnabled(const string& type, const bool& enabled) { enabled_hardware[type] = enabled; }
             inline bool IsHardwareEnabled(const string& type) const {
@@ -171,6 +251,33 @@ extern "C" _declspec(dllexport) bool UpdateSensorData(ArgusMonitorLink* argus_mo
     return argus_monitor_link_ptr->UpdateSensorData(update);
 }
 
+// Update the non static sensors like UpdateSensorData, but deliver the values resampled onto the fixed timeline set with SetResampling
+// every batch holds the values of all sensors known at the given timestamp, ids and values are only valid during the call
+// returns the amount of delivered batches
+extern "C" _declspec(dllexport) uint32_t UpdateResampledSensorData(ArgusMonitorLink* argus_monitor_link_ptr,
+                                                                   void (deliver)(const uint64_t timestamp_ms,
+                                                                                  const uint32_t count,
+                                                                                  const char* const* sensor_ids,
+                                                                                  const float* values))
+{
+    return argus_monitor_link_ptr->UpdateResampledSensorData(deliver);
+}
+
+// Set the fixed timeline of UpdateResampledSensorData, an interval of 0 disables the resampling
+// policy:
+//  0: hold the last observed value
+//  1: interpolate linearly between the observed cycles, this delays the output by up to one cycle
+extern "C" _declspec(dllexport) void SetResampling(ArgusMonitorLink* argus_monitor_link_ptr, const uint64_t interval_ms, const int policy)
+{
+    argus_monitor_link_ptr->SetResampling(interval_ms, policy);
+}
+
+// Check whether the resampling is enabled
+extern "C" _declspec(dllexport) bool IsResamplingEnabled(ArgusMonitorLink* argus_monitor_link_ptr)
+{
+    return argus_monitor_link_ptr->IsResamplingEnabled();
+}
+
 // Set the given hardware type to enabled/disabled
 extern "C" _declspec(dllexport) void SetHardwareEnabled(ArgusMonitorLink* argus_monitor_link_ptr, const char* type, const bool enabled)
 {
@@ -183,6 +290,171 @@ extern "C" _declspec(dllexport) bool IsHardwareEnabled(ArgusMonitorLink* argus_m
     return argus_monitor_link_ptr->IsHardwareEnabled(type);
 }
 
+// Get the read-only metadata table of the current sensor layout, one fixed-size record per sensor with all strings as offsets into string_pool
+// both arrays are owned by the link and are only rebuilt by this method, they stay valid until a later call returns a different generation
+// return: the generation of the layout the table belongs to
+extern "C" _declspec(dllexport) uint32_t GetSensorMetadataTable(ArgusMonitorLink* argus_monitor_link_ptr,
+                                                                const SensorMetadataRecord** records,
+                                                                uint32_t* record_count,
+                                                                const char** string_pool,
+                                                                uint32_t* string_pool_size)
+{
+    return argus_monitor_link_ptr->GetSensorMetadataTable(*records, *record_count, *string_pool, *string_pool_size);
+}
+
+// Capture the current sensor data and return a cursor to pull the sensors of enabled hardware one by one
+// the cursor needs to be released with EndIterate
+extern "C" _declspec(dllexport) void* BeginIterate(ArgusMonitorLink* argus_monitor_link_ptr)
+{
+    return (void*) new SensorCursor(argus_monitor_link_ptr->Snapshot());
+}
+
+// Decode the next sensor of the captured data into the given record
+// returns false once all sensors have been pulled
+extern "C" _declspec(dllexport) bool Next(SensorCursor* sensor_cursor_ptr, SensorSampleRecord* record)
+{
+    return sensor_cursor_ptr->Next(*record);
+}
+
+// Delete the given cursor
+extern "C" _declspec(dllexport) void EndIterate(SensorCursor* sensor_cursor_ptr)
+{
+    delete sensor_cursor_ptr;
+}
+
+// Get the current value of a single sensor by the id passed to UpdateSensorData, without walking all other sensors
+// only sensors provided by Argus Monitor directly can be looked up, not the ones calculated by the link
+// returns false if no sensor with the given id exists
+extern "C" _declspec(dllexport) bool GetSensorValue(ArgusMonitorLink* argus_monitor_link_ptr, const char* sensor_id, float* value)
+{
+    return argus_monitor_link_ptr->GetSensorValue(sensor_id, *value);
+}
+
+// Get the current values of count sensors by their ids, unknown sensors are set to NaN
+// returns the amount of sensors that were found
+extern "C" _declspec(dllexport) uint32_t GetSensorValues(ArgusMonitorLink* argus_monitor_link_ptr,
+                                                         const char* const* sensor_ids,
+                                                         float* values,
+                                                         const uint32_t count)
+{
+    return argus_monitor_link_ptr->GetSensorValues(sensor_ids, values, count);
+}
+
+// Enable or disable the per sensor histograms of all sensors provided by Argus Monitor
+// values are recorded as passed to UpdateSensorData and weighted by the time they were held, disabling them frees all histograms
+extern "C" _declspec(dllexport) void SetHistogramsEnabled(ArgusMonitorLink* argus_monitor_link_ptr, const bool enabled)
+{
+    argus_monitor_link_ptr->SetHistogramsEnabled(enabled);
+}
+
+// Check whether the histograms are enabled
+extern "C" _declspec(dllexport) bool IsHistogramsEnabled(ArgusMonitorLink* argus_monitor_link_ptr)
+{
+    return argus_monitor_link_ptr->IsHistogramsEnabled();
+}
+
+// Get count percentiles of the given sensor, quantiles are in [0, 1] (e.g. 0.99 for p99)
+// returns false if there is no histogram for the given sensor
+extern "C" _declspec(dllexport) bool GetSensorPercentiles(ArgusMonitorLink* argus_monitor_link_ptr,
+                                                          const char* sensor_id,
+                                                          const double* quantiles,
+                                                          float* values,
+                                                          const uint32_t count)
+{
+    return argus_monitor_link_ptr->GetSensorPercentiles(sensor_id, quantiles, values, count);
+}
+
+// Get the share of time the given sensor spent above the threshold
+// returns false if there is no histogram for the given sensor
+extern "C" _declspec(dllexport) bool GetSensorFractionAbove(ArgusMonitorLink* argus_monitor_link_ptr,
+                                                            const char* sensor_id,
+                                                            const float threshold,
+                                                            double* fraction)
+{
+    return argus_monitor_link_ptr->GetSensorFractionAbove(sensor_id, threshold, *fraction);
+}
+
+// Get the milliseconds spent in every bucket and the bucket lower bounds of the given sensor's histogram without copying them
+// both arrays are owned by the link and stay valid until the histograms are disabled
+// returns the amount of buckets, 0 if there is no histogram for the given sensor
+extern "C" _declspec(dllexport) uint32_t GetSensorHistogram(ArgusMonitorLink* argus_monitor_link_ptr,
+                                                            const char* sensor_id,
+                                                            const uint64_t** durations_ms,
+                                                            const float** lower_bounds,
+                                                            uint64_t* total_ms)
+{
+    return argus_monitor_link_ptr->GetSensorHistogram(sensor_id, *durations_ms, *lower_bounds, *total_ms);
+}
+
+// Enable or disable the integrators, while enabled UpdateSensorData additionally publishes
+//   <Hardware>_Energy_<Group>_<SensorIndex>_<DataIndex>:         Wh consumed by every GPU power sensor
+//   <Hardware>_Data_<Group>_<SensorIndex>_<DataIndex>:           bytes transferred by every network and drive transfer rate sensor
+//   <Hardware>_Duration_<Group>_Above_<SensorIndex>_<DataIndex>: seconds every sensor with a threshold spent above it
+// disabling them resets all totals
+extern "C" _declspec(dllexport) void SetIntegratorsEnabled(ArgusMonitorLink* argus_monitor_link_ptr, const bool enabled)
+{
+    argus_monitor_link_ptr->SetIntegratorsEnabled(enabled);
+}
+
+// Check whether the integrators are enabled
+extern "C" _declspec(dllexport) bool IsIntegratorsEnabled(ArgusMonitorLink* argus_monitor_link_ptr)
+{
+    return argus_monitor_link_ptr->IsIntegratorsEnabled();
+}
+
+// Reset all integrated totals, configured thresholds are kept
+extern "C" _declspec(dllexport) void ResetIntegrators(ArgusMonitorLink* argus_monitor_link_ptr)
+{
+    argus_monitor_link_ptr->ResetIntegrators();
+}
+
+// Count the time the given sensor spends above the threshold, compared against the value passed to UpdateSensorData
+// setting a new threshold restarts the count
+extern "C" _declspec(dllexport) void SetSensorThreshold(ArgusMonitorLink* argus_monitor_link_ptr, const char* sensor_id, const float threshold)
+{
+    argus_monitor_link_ptr->SetSensorThreshold(sensor_id, threshold);
+}
+
+// Stop counting the time the given sensor spends above its threshold
+extern "C" _declspec(dllexport) void ClearSensorThreshold(ArgusMonitorLink* argus_monitor_link_ptr, const char* sensor_id)
+{
+    argus_monitor_link_ptr->ClearSensorThreshold(sensor_id);
+}
+
+// Enable or disable the multi-resolution rollups (raw / 1s / 1m / 1h) of all sensors published by UpdateSensorData
+// disabling them frees all collected rollups
+extern "C" _declspec(dllexport) void SetRollupsEnabled(ArgusMonitorLink* argus_monitor_link_ptr, const bool enabled)
+{
+    argus_monitor_link_ptr->SetRollupsEnabled(enabled);
+}
+
+// Check whether the rollups are enabled
+extern "C" _declspec(dllexport) bool IsRollupsEnabled(ArgusMonitorLink* argus_monitor_link_ptr)
+{
+    return argus_monitor_link_ptr->IsRollupsEnabled();
+}
+
+// Pass the rollup buckets of the given sensor covering the last range_ms milliseconds to the given method, oldest first
+// the coarsest tier with buckets no wider than resolution_ms that still covers the range is used
+// return:
+//  -1: no rollups available for the given sensor
+//   0: raw samples
+//   1: 1 second buckets
+//   2: 1 minute buckets
+//   3: 1 hour buckets
+extern "C" _declspec(dllexport) int QueryRollups(ArgusMonitorLink* argus_monitor_link_ptr,
+                                                 const char* sensor_id,
+                                                 const uint64_t range_ms,
+                                                 const uint64_t resolution_ms,
+                                                 void (process_bucket)(const uint64_t start_ms,
+                                                                       const float min,
+                                                                       const float max,
+                                                                       const float average,
+                                                                       const uint32_t count))
+{
+    return argus_monitor_link_ptr->QueryRollups(sensor_id, range_ms, resolution_ms, process_bucket);
+}
+
 // Delete the given instance
 // This needs to be called to ensure proper memory cleanup
 extern "C" _declspec(dllexport) void Destroy(ArgusMonitorLink* argus_monitor_link_ptr)
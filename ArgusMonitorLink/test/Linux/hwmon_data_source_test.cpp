@@ -0,0 +1,163 @@
+/**
+Test of the Linux hwmon data source against the fake sysfs/procfs tree in fixture/.
+The fixture is copied to a temporary directory first, since the test rewrites some of the files between cycles.
+
+Build and run from this directory:
+    g++ -std=c++20 -I../../src hwmon_data_source_test.cpp -o hwmon_data_source_test && ./hwmon_data_source_test
+
+Copyright (C) 2025 Zeanon
+Original License from https://github.com/argotronic/argus_data_api still applies.
+**/
+
+#include "Linux/hwmon_data_source.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+using namespace argus_monitor::data_api;
+
+namespace
+{
+    int failures{ 0 };
+
+    void Check(const bool& condition, const char* expression, const int& line)
+    {
+        if (!condition)
+        {
+            fprintf(stderr, "line %d: check failed: %s\n", line, expression);
+            ++failures;
+        }
+    }
+
+    bool Near(const double& value, const double& expected) { return fabs(value - expected) < 0.001; }
+
+    void WriteFile(const filesystem::path& path, const string& content)
+    {
+        ofstream file(path, ios::trunc);
+        file << content;
+    }
+
+    // first sensor of the given type in the frame
+    const ArgusMonitorSensorData* SensorsOfType(const ArgusMonitorData& data, const ARGUS_MONITOR_SENSOR_TYPE& sensor_type)
+    {
+        return &data.SensorData[data.OffsetForSensorType[sensor_type]];
+    }
+}
+
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+
+int main(int argc, char* argv[])
+{
+    const filesystem::path fixture = filesystem::path(argc > 1 ? argv[1] : "fixture");
+    const filesystem::path root = filesystem::temp_directory_path() / ("hwmon_data_source_test_" + to_string(getpid()));
+    filesystem::remove_all(root);
+    filesystem::copy(fixture, root, filesystem::copy_options::recursive);
+
+    {
+        HwmonDataSource data_source((root / "hwmon").string(), (root / "proc").string());
+        CHECK(0 == data_source.Open());
+        CHECK(data_source.IsOpen());
+
+        auto data = make_unique<ArgusMonitorData>();
+        data_source.Sample(*data);
+
+        CHECK(0x4D677241 == data->Signature);
+        CHECK(1 == data->CycleCounter);
+        CHECK(17 == data->TotalSensorCount);
+
+        // the sensors are grouped by type in enum order
+        const pair<ARGUS_MONITOR_SENSOR_TYPE, uint32_t> expected_counts[] = {
+            { SENSOR_TYPE_TEMPERATURE, 2 },
+            { SENSOR_TYPE_FAN_SPEED_RPM, 1 },
+            { SENSOR_TYPE_FAN_CONTROL_VALUE, 1 },
+            { SENSOR_TYPE_CPU_TEMPERATURE, 1 },
+            { SENSOR_TYPE_CPU_TEMPERATURE_ADDITIONAL, 1 },
+            { SENSOR_TYPE_GPU_TEMPERATURE, 2 },
+            { SENSOR_TYPE_GPU_FAN_SPEED_PERCENT, 1 },
+            { SENSOR_TYPE_GPU_FAN_SPEED_RPM, 1 },
+            { SENSOR_TYPE_GPU_POWER, 1 },
+            { SENSOR_TYPE_DISK_TEMPERATURE, 1 },
+            { SENSOR_TYPE_CPU_LOAD, 2 },
+            { SENSOR_TYPE_RAM_USAGE, 3 }
+        };
+        uint32_t offset{ 0 };
+        for (const auto& expected : expected_counts)
+        {
+            CHECK(offset == data->OffsetForSensorType[expected.first]);
+            CHECK(expected.second == data->SensorCount[expected.first]);
+            for (uint32_t index{}; index < expected.second; ++index)
+            {
+                CHECK(expected.first == data->SensorData[offset + index].SensorType);
+            }
+            offset += expected.second;
+        }
+        CHECK(0 == data->SensorCount[SENSOR_TYPE_NETWORK_SPEED]);
+
+        // mainboard chip: UTF-8 label, generated label, data index per sensor type and instance
+        const auto* temperatures = SensorsOfType(*data, SENSOR_TYPE_TEMPERATURE);
+        CHECK(wstring(L"Système") == temperatures[0].Label);
+        CHECK(wstring(L"nct6798 temp2") == temperatures[1].Label);
+        CHECK(wstring(L"°C") == temperatures[0].UnitString);
+        CHECK(Near(temperatures[0].Value, 33));
+        CHECK(Near(temperatures[1].Value, 35));
+        CHECK(0 == temperatures[0].DataIndex && 1 == temperatures[1].DataIndex);
+        CHECK(0 == temperatures[0].SensorIndex && 0 == temperatures[1].SensorIndex);
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_FAN_SPEED_RPM)[0].Value, 900));
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_FAN_CONTROL_VALUE)[0].Value, 100));
+
+        // CPU chip: Tccd readings are additional temperatures
+        CHECK(wstring(L"Tctl") == SensorsOfType(*data, SENSOR_TYPE_CPU_TEMPERATURE)[0].Label);
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_CPU_TEMPERATURE)[0].Value, 45.5));
+        CHECK(wstring(L"Tccd1") == SensorsOfType(*data, SENSOR_TYPE_CPU_TEMPERATURE_ADDITIONAL)[0].Label);
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_CPU_TEMPERATURE_ADDITIONAL)[0].Value, 40));
+
+        // GPU chip: pwm is scaled to percent, the averaged power is preferred and scaled to W
+        const auto* gpu_temperatures = SensorsOfType(*data, SENSOR_TYPE_GPU_TEMPERATURE);
+        CHECK(Near(gpu_temperatures[0].Value, 60) && Near(gpu_temperatures[1].Value, 70));
+        CHECK(0 == gpu_temperatures[0].DataIndex && 1 == gpu_temperatures[1].DataIndex);
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_GPU_FAN_SPEED_PERCENT)[0].Value, 20));
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_GPU_FAN_SPEED_RPM)[0].Value, 1200));
+        CHECK(wstring(L"PPT") == SensorsOfType(*data, SENSOR_TYPE_GPU_POWER)[0].Label);
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_GPU_POWER)[0].Value, 150));
+
+        // drive chip
+        CHECK(wstring(L"Composite") == SensorsOfType(*data, SENSOR_TYPE_DISK_TEMPERATURE)[0].Label);
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_DISK_TEMPERATURE)[0].Value, 38));
+
+        // the first cycle only establishes the CPU load baseline
+        const auto* cpu_loads = SensorsOfType(*data, SENSOR_TYPE_CPU_LOAD);
+        CHECK(Near(cpu_loads[0].Value, 0) && Near(cpu_loads[1].Value, 0));
+        CHECK(0 == cpu_loads[0].DataIndex && 1 == cpu_loads[1].DataIndex);
+
+        // RAM: total, used (total - available) in MB and the percentage
+        const auto* ram = SensorsOfType(*data, SENSOR_TYPE_RAM_USAGE);
+        CHECK(Near(ram[0].Value, 16000000 * 1024.0 / 1000000));
+        CHECK(Near(ram[1].Value, 12000000 * 1024.0 / 1000000));
+        CHECK(Near(ram[2].Value, 75));
+        CHECK(0 == ram[0].DataIndex && 1 == ram[1].DataIndex && 2 == ram[2].DataIndex);
+
+        // the files stay open, a changed value is picked up by the next cycle
+        WriteFile(root / "hwmon" / "hwmon0" / "temp1_input", "50000\n");
+        WriteFile(root / "proc" / "stat", "cpu  0\ncpu0 175 0 100 825 0 0 0 0 0 0\ncpu1 100 0 100 900 0 0 0 0 0 0\n");
+        data_source.Sample(*data);
+
+        CHECK(2 == data->CycleCounter);
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_CPU_TEMPERATURE)[0].Value, 50));
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_CPU_LOAD)[0].Value, 75));
+        CHECK(Near(SensorsOfType(*data, SENSOR_TYPE_CPU_LOAD)[1].Value, 0));
+
+        CHECK(0 == data_source.Close());
+        CHECK(!data_source.IsOpen());
+    }
+
+    {
+        HwmonDataSource data_source((root / "missing").string(), (root / "proc").string());
+        CHECK(1 == data_source.Open());
+    }
+
+    filesystem::remove_all(root);
+
+    if (0 == failures) printf("all checks passed\n");
+    return 0 == failures ? 0 : 1;
+}